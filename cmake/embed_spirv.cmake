@@ -0,0 +1,51 @@
+# turns a spir-v binary into a header with the module as a constexpr u32 array
+# usage: cmake -DINPUT=<spv> -DOUTPUT=<hpp> -DSOURCE_NAME=<shader.vert> -DIDENTIFIER=<SHADER_VERT> -P embed_spirv.cmake
+
+foreach(var INPUT OUTPUT SOURCE_NAME IDENTIFIER)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "embed_spirv.cmake: ${var} is not set")
+    endif()
+endforeach()
+
+file(READ "${INPUT}" spirv_hex HEX)
+string(LENGTH "${spirv_hex}" spirv_hex_length)
+
+math(EXPR spirv_remainder "${spirv_hex_length} % 8")
+if(spirv_hex_length EQUAL 0 OR NOT spirv_remainder EQUAL 0)
+    message(FATAL_ERROR "embed_spirv.cmake: ${INPUT} is not a whole number of 32-bit words")
+endif()
+
+math(EXPR spirv_word_count "${spirv_hex_length} / 8")
+
+# spir-v words are stored little endian, so every group of four bytes is flipped into a literal
+string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1, " spirv_words "${spirv_hex}")
+# cmake regexes have no {n} quantifier, so the eight words per line are spelled out
+string(REPEAT "0x[0-9a-f]+, " 7 spirv_line_pattern)
+string(REGEX REPLACE "(${spirv_line_pattern}0x[0-9a-f]+,) " "\\1\n        " spirv_words "${spirv_words}")
+string(REGEX REPLACE "[ \n]+$" "" spirv_words "${spirv_words}")
+
+string(TOUPPER "SYLK_SHADERS_${IDENTIFIER}_HPP" header_guard)
+
+set(header_content "//
+// Generated from ${SOURCE_NAME} by cmake/embed_spirv.cmake, do not edit.
+//
+
+#ifndef ${header_guard}
+#define ${header_guard}
+
+#include <sylk/core/utils/short_types.hpp>
+
+#include <array>
+
+namespace sylk {
+
+    inline constexpr std::array<u32, ${spirv_word_count}> ${IDENTIFIER} = {
+        ${spirv_words}
+    };
+
+}  // namespace sylk
+
+#endif  // ${header_guard}
+")
+
+file(WRITE "${OUTPUT}" "${header_content}")
@@ -6,6 +6,7 @@
 #define SYLK_CORE_UTILS_ALL_HPP
 
 #include "cast.hpp"
+#include "hash.hpp"
 #include "log.hpp"
 #include "short_types.hpp"
 
@@ -0,0 +1,39 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_CORE_UTILS_HASH_HPP
+#define SYLK_CORE_UTILS_HASH_HPP
+
+#include "short_types.hpp"
+
+#include <type_traits>
+
+namespace sylk {
+    inline constexpr u64 FNV_OFFSET_BASIS = 0xcbf29ce484222325;
+    inline constexpr u64 FNV_PRIME        = 0x100000001b3;
+
+    // not meant to be cryptographically sound, only fast and stable across runs
+    inline auto fnv1a(const void* data, const u64 size, u64 seed = FNV_OFFSET_BASIS) -> u64 {
+        const auto* bytes = static_cast<const u8*>(data);
+
+        for (u64 i = 0; i < size; ++i) {
+            seed ^= bytes[i];
+            seed *= FNV_PRIME;
+        }
+
+        return seed;
+    }
+
+    template<typename T>
+        requires std::has_unique_object_representations_v<T>
+    auto hash_value(const T& value, const u64 seed = FNV_OFFSET_BASIS) -> u64 {
+        return fnv1a(&value, sizeof(T), seed);
+    }
+
+    inline auto hash_combine(const u64 seed, const u64 value) -> u64 {
+        return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+    }
+}  // namespace sylk
+
+#endif  // SYLK_CORE_UTILS_HASH_HPP
@@ -60,7 +60,8 @@ namespace sylk {
         }
 
         inline static bool      was_initialized {false};
-        inline static SpdLogger logger {spdlog::stdout_color_st("Sylk")};
+        // pipelines are compiled on worker threads, which log too
+        inline static SpdLogger logger {spdlog::stdout_color_mt("Sylk")};
     };
 
     template<typename... Args>
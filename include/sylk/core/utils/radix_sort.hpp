@@ -0,0 +1,124 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_CORE_UTILS_RADIXSORT_HPP
+#define SYLK_CORE_UTILS_RADIXSORT_HPP
+
+#include "short_types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <barrier>
+#include <concepts>
+#include <cstring>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace sylk {
+
+    // below this many elements waking up more threads costs more than it saves
+    inline constexpr u64 PARALLEL_RADIX_SORT_THRESHOLD = 64 * 1024;
+
+    // a stable lsd radix sort on the u64 that key_of() returns, a byte per pass
+    // every element is moved eight times at most, passes over a byte all keys share are skipped, which for packed keys
+    // with mostly constant high bits is where most of the win over a comparison sort comes from
+    // with more than one thread each of them owns a contiguous chunk, the chunks are histogrammed and scattered in
+    // parallel and only meet at a barrier between the two, the calling thread is one of them
+    // scratch has to be at least as large as elements, the result always ends up in elements
+    template<typename T, typename KeyFn>
+        requires std::is_trivially_copyable_v<T> && std::same_as<std::invoke_result_t<KeyFn, const T&>, u64>
+    void radix_sort(const std::span<T> elements, const std::span<T> scratch, const KeyFn key_of, u32 thread_count = 1) {
+        constexpr u32 RADIX_BITS = 8;
+        constexpr u32 BUCKETS    = 1 << RADIX_BITS;
+        constexpr u32 PASSES     = sizeof(u64) * 8 / RADIX_BITS;
+
+        using Histogram = std::array<u64, BUCKETS>;
+
+        const u64 count = elements.size();
+        if (count < 2) {
+            return;
+        }
+
+        if (count < PARALLEL_RADIX_SORT_THRESHOLD) {
+            thread_count = 1;
+        }
+        thread_count = std::clamp(thread_count, 1u, std::max(std::thread::hardware_concurrency(), 1u));
+
+        const u64 chunk_size = (count + thread_count - 1) / thread_count;
+
+        std::vector<Histogram> histograms(thread_count);
+        std::barrier           sync(thread_count);
+
+        const auto work = [&](const u32 thread) {
+            const u64 begin = std::min(count, thread * chunk_size);
+            const u64 end   = std::min(count, begin + chunk_size);
+
+            // every thread swaps its own copy of the pointers, in lockstep with the others
+            T* from = elements.data();
+            T* to   = scratch.data();
+
+            for (u32 pass = 0; pass < PASSES; ++pass) {
+                const u32 shift = pass * RADIX_BITS;
+
+                auto& histogram = histograms[thread];
+                histogram.fill(0);
+                for (u64 i = begin; i < end; ++i) {
+                    ++histogram[(key_of(from[i]) >> shift) & (BUCKETS - 1)];
+                }
+
+                sync.arrive_and_wait();
+
+                // the offset of this chunk's first element in each bucket, behind every smaller bucket and behind this
+                // bucket's elements in earlier chunks, the skip is decided on data every thread sees the same
+                Histogram offsets {};
+                bool      skip    = false;
+                u64       running = 0;
+                for (u32 bucket = 0; bucket < BUCKETS; ++bucket) {
+                    u64 total = 0;
+                    for (u32 other = 0; other < thread_count; ++other) {
+                        if (other == thread) {
+                            offsets[bucket] = running + total;
+                        }
+                        total += histograms[other][bucket];
+                    }
+
+                    skip    = skip || total == count;
+                    running += total;
+                }
+
+                if (!skip) {
+                    for (u64 i = begin; i < end; ++i) {
+                        to[offsets[(key_of(from[i]) >> shift) & (BUCKETS - 1)]++] = from[i];
+                    }
+                }
+
+                // nobody may start the next histogram while others still read this one, or scatter from `to`
+                sync.arrive_and_wait();
+
+                if (!skip) {
+                    std::swap(from, to);
+                }
+            }
+
+            if (from != elements.data()) {
+                std::memcpy(elements.data() + begin, from + begin, (end - begin) * sizeof(T));
+            }
+        };
+
+        {
+            std::vector<std::jthread> helpers;
+            helpers.reserve(thread_count - 1);
+            for (u32 thread = 1; thread < thread_count; ++thread) {
+                helpers.emplace_back(work, thread);
+            }
+
+            work(0);
+        }
+    }
+
+}  // namespace sylk
+
+#endif  // SYLK_CORE_UTILS_RADIXSORT_HPP
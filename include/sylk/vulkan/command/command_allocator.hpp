@@ -0,0 +1,54 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_COMMAND_COMMANDALLOCATOR_HPP
+#define SYLK_VULKAN_COMMAND_COMMANDALLOCATOR_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <vector>
+
+namespace sylk {
+
+    // keeps one transient command pool per frame slot and recording thread
+    // command buffers are handed out linearly and never freed or reset individually, instead the whole pool is reset
+    // once the slot comes around again, which is the cheap path on every driver
+    // anything allocated is only valid until the next begin_frame() of the same slot, so it has to be submitted in that frame
+    class CommandAllocator {
+      public:
+        explicit CommandAllocator(const vk::Device& device);
+
+        void create(u32 queue_family_index, u32 frame_count, u32 thread_count);
+        void destroy();
+
+        // the caller must have waited on the fence guarding this slot
+        void begin_frame(u32 frame_slot);
+
+        // each thread must only ever pass its own index, pools are not shared between threads
+        auto allocate(u32 thread_index = 0, vk::CommandBufferLevel level = vk::CommandBufferLevel::ePrimary) -> vk::CommandBuffer;
+
+        SYLK_NODISCARD auto thread_count() const -> u32;
+
+      private:
+        struct Pool {
+            vk::CommandPool                pool;
+            std::vector<vk::CommandBuffer> primary;
+            std::vector<vk::CommandBuffer> secondary;
+            u32                            next_primary   = 0;
+            u32                            next_secondary = 0;
+        };
+
+        void grow(Pool& pool, vk::CommandBufferLevel level) const;
+
+      private:
+        const vk::Device& device_;
+        std::vector<Pool> pools_;  // indexed as [frame slot * thread count + thread index]
+        u32               thread_count_;
+        u32               current_slot_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_COMMAND_COMMANDALLOCATOR_HPP
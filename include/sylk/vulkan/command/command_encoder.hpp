@@ -0,0 +1,95 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_COMMAND_COMMANDENCODER_HPP
+#define SYLK_VULKAN_COMMAND_COMMANDENCODER_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/command/dynamic_state_tracker.hpp>
+#include <sylk/vulkan/pipeline/pipeline_desc.hpp>
+#include <sylk/vulkan/pipeline/shader_object_cache.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <array>
+#include <optional>
+
+namespace sylk {
+
+    // a thin layer over a command buffer that remembers what is bound and drops binds and state that are already current
+    // it only knows about what goes through it, anything recorded on cmd() directly that binds or sets the same things
+    // has to be followed by invalidate(), draws, push constants and barriers go through cmd() as they are
+    class CommandEncoder {
+      public:
+        static constexpr u32 MAX_VERTEX_BINDINGS = 8;
+        static constexpr u32 MAX_SETS            = 8;
+
+        struct Stats {
+            u32 binds_issued   = 0;
+            u32 binds_skipped  = 0;
+            u32 states_issued  = 0;  // dynamic state, the viewport and scissor included
+            u32 states_skipped = 0;
+        };
+
+      public:
+        // nothing is bound at the start of a command buffer, so this forgets everything and resets the stats
+        void begin(vk::CommandBuffer cmd, bool dynamic_blend);
+        void invalidate();
+
+        void bind_pipeline(vk::PipelineBindPoint bind_point, vk::Pipeline pipeline);
+        // binding shader objects and binding a graphics pipeline undo each other
+        void bind_program(const ShaderObjectCache::Program& program);
+
+        void bind_vertex_buffer(u32 binding, vk::Buffer buffer, vk::DeviceSize offset = 0);
+        void bind_index_buffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType type);
+        // without dynamic offsets, sets that take them are bound on cmd() directly
+        void bind_descriptor_set(vk::PipelineBindPoint bind_point, vk::PipelineLayout layout, u32 set, vk::DescriptorSet descriptor_set);
+
+        void set_viewport(const vk::Viewport& viewport);
+        void set_scissor(const vk::Rect2D& scissor);
+        void set_render_state(const RenderState& state);
+
+        SYLK_NODISCARD auto cmd() const -> vk::CommandBuffer;
+        SYLK_NODISCARD auto stats() const -> Stats;
+
+      private:
+        struct VertexBinding {
+            vk::Buffer     buffer;
+            vk::DeviceSize offset = 0;
+        };
+
+        struct IndexBinding {
+            vk::Buffer     buffer;
+            vk::DeviceSize offset = 0;
+            vk::IndexType  type   = vk::IndexType::eUint16;
+        };
+
+        struct SetBinding {
+            vk::PipelineLayout layout;
+            vk::DescriptorSet  set;
+        };
+
+        // graphics and compute, other bind points aren't shadowed
+        static constexpr u32 BIND_POINTS = 2;
+
+        // bump the right counter and say whether the command has to be recorded
+        auto issue_bind(bool current) -> bool;
+        auto issue_state(bool current) -> bool;
+
+      private:
+        vk::CommandBuffer   cmd_;
+        DynamicStateTracker dynamic_state_;
+        Stats               stats_;
+
+        std::array<vk::Pipeline, BIND_POINTS>                     pipelines_;
+        const ShaderObjectCache::Program*                         program_ = nullptr;
+        std::array<VertexBinding, MAX_VERTEX_BINDINGS>            vertex_buffers_;
+        IndexBinding                                              index_buffer_;
+        std::array<std::array<SetBinding, MAX_SETS>, BIND_POINTS> sets_;
+        std::optional<vk::Viewport>                               viewport_;
+        std::optional<vk::Rect2D>                                 scissor_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_COMMAND_COMMANDENCODER_HPP
@@ -0,0 +1,46 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_COMMAND_DYNAMICSTATETRACKER_HPP
+#define SYLK_VULKAN_COMMAND_DYNAMICSTATETRACKER_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/pipeline/pipeline_desc.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+namespace sylk {
+
+    // remembers the dynamic state recorded into a command buffer and only records the parts of a RenderState that changed
+    // every pipeline in the PipelineLibrary shares the same dynamic state, so binding another one doesn't invalidate it
+    class DynamicStateTracker {
+      public:
+        struct Stats {
+            u32 recorded = 0;
+            u32 skipped  = 0;
+        };
+
+      public:
+        // dynamic state is undefined at the start of every command buffer, so everything is recorded on the first apply()
+        void begin(vk::CommandBuffer buffer, bool dynamic_blend);
+        void apply(const RenderState& state);
+        // for state recorded behind the tracker's back, the next apply() records everything again
+        void invalidate();
+
+        SYLK_NODISCARD auto stats() const -> Stats;
+
+      private:
+        template<typename T, typename Record>
+        void set(T& current, const T& wanted, Record&& record);
+
+      private:
+        vk::CommandBuffer buffer_;
+        RenderState       current_;
+        bool              dynamic_blend_ = false;
+        bool              valid_         = false;
+        Stats             stats_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_COMMAND_DYNAMICSTATETRACKER_HPP
@@ -0,0 +1,90 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_COMMAND_QUEUE_HPP
+#define SYLK_VULKAN_COMMAND_QUEUE_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/sync/timeline_semaphore.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <span>
+
+namespace sylk {
+
+    class Queue {
+      public:
+        // value is ignored for binary semaphores
+        struct SemaphoreDependency {
+            vk::Semaphore           semaphore;
+            u64                     value  = 0;
+            vk::PipelineStageFlags2 stages = vk::PipelineStageFlagBits2::eAllCommands;
+        };
+
+        struct SubmitData {
+            std::span<const vk::CommandBuffer>   command_buffers;
+            std::span<const SemaphoreDependency> waits;
+            std::span<const SemaphoreDependency> signals;
+            vk::Fence                            fence;
+        };
+
+        // exclusive resources have to be released by the queue family that last used them
+        // and acquired by the family that uses them next, both halves describing the same transfer
+        struct BufferTransfer {
+            vk::Buffer              buffer;
+            vk::DeviceSize          offset = 0;
+            vk::DeviceSize          size   = VK_WHOLE_SIZE;
+            u32                     src_family;
+            u32                     dst_family;
+            vk::PipelineStageFlags2 src_stages;
+            vk::AccessFlags2        src_access;
+            vk::PipelineStageFlags2 dst_stages;
+            vk::AccessFlags2        dst_access;
+        };
+
+        struct ImageTransfer {
+            vk::Image                 image;
+            vk::ImageSubresourceRange range;
+            vk::ImageLayout           old_layout;
+            vk::ImageLayout           new_layout;
+            u32                       src_family;
+            u32                       dst_family;
+            vk::PipelineStageFlags2   src_stages;
+            vk::AccessFlags2          src_access;
+            vk::PipelineStageFlags2   dst_stages;
+            vk::AccessFlags2          dst_access;
+        };
+
+      public:
+        explicit Queue(const vk::Device& device);
+
+        void create(vk::Queue queue, u32 family_index);
+        void destroy();
+
+        // every submission also signals this queue's timeline, the returned value can be waited on by other queues
+        auto submit(SubmitData data) -> u64;
+
+        // submits everything through a single vkQueueSubmit2, the fences of the individual entries are ignored
+        auto submit_batch(std::span<const SubmitData> submits, vk::Fence fence) -> u64;
+        void wait_idle() const;
+
+        SYLK_NODISCARD auto wait_point(u64 value, vk::PipelineStageFlags2 stages) const -> SemaphoreDependency;
+        SYLK_NODISCARD auto get_timeline() const -> const TimelineSemaphore&;
+        SYLK_NODISCARD auto get_handle() const -> vk::Queue;
+        SYLK_NODISCARD auto family_index() const -> u32;
+
+        static void release(vk::CommandBuffer buffer, const BufferTransfer& transfer);
+        static void acquire(vk::CommandBuffer buffer, const BufferTransfer& transfer);
+        static void release(vk::CommandBuffer buffer, const ImageTransfer& transfer);
+        static void acquire(vk::CommandBuffer buffer, const ImageTransfer& transfer);
+
+      private:
+        vk::Queue         queue_;
+        u32               family_index_;
+        TimelineSemaphore timeline_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_COMMAND_QUEUE_HPP
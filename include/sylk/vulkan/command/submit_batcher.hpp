@@ -0,0 +1,72 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_COMMAND_SUBMITBATCHER_HPP
+#define SYLK_VULKAN_COMMAND_SUBMITBATCHER_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/command/queue.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <vector>
+
+namespace sylk {
+
+    // collects every submission made during a frame and hands them to the driver in as few vkQueueSubmit2 calls as possible
+    // entries for the same queue end up in one call, unless an entry waits on a semaphore another queue has yet to
+    // submit a signal for, in which case that queue is flushed first so signals always reach the driver before their waits
+    class SubmitBatcher {
+      public:
+        struct Stats {
+            u32 submit_calls    = 0;
+            u32 submit_infos    = 0;
+            u32 command_buffers = 0;
+        };
+
+      public:
+        // spans are copied, so the caller's storage doesn't need to outlive the flush
+        void add(Queue& queue, Queue::SubmitData data);
+        void flush();
+
+        // returns the stats gathered since the previous call
+        auto end_frame() -> Stats;
+
+        SYLK_NODISCARD auto last_frame_stats() const -> Stats;
+
+      private:
+        struct Group {
+            std::vector<vk::CommandBuffer>          command_buffers;
+            std::vector<Queue::SemaphoreDependency> waits;
+            std::vector<Queue::SemaphoreDependency> signals;
+        };
+
+        struct Entry {
+            Queue*    queue;
+            Group     group;
+            vk::Fence fence;
+        };
+
+        struct Call {
+            Queue*             queue;
+            std::vector<Group> groups;
+            vk::Fence          fence;
+            bool               open = true;
+        };
+
+        void append(Call& call, const Group& group) const;
+        void submit(Call& call);
+
+        SYLK_NODISCARD auto signals_semaphore(const Call& call, vk::Semaphore semaphore) const -> bool;
+
+      private:
+        std::vector<Entry> entries_;
+        std::vector<Call>  calls_;
+
+        Stats frame_stats_;
+        Stats last_frame_stats_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_COMMAND_SUBMITBATCHER_HPP
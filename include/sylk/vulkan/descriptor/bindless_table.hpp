@@ -0,0 +1,99 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_DESCRIPTOR_BINDLESSTABLE_HPP
+#define SYLK_VULKAN_DESCRIPTOR_BINDLESSTABLE_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/descriptor/descriptor_buffer.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <utility>
+#include <vector>
+
+namespace sylk {
+
+    // one global descriptor set holding every sampled image, sampler and storage buffer, which shaders index with
+    // plain integers, usually out of push constants, see shaders/include/bindless.glsl
+    // it's bound once per frame and stays bound no matter how many pipelines or materials a frame goes through
+    // the arrays are partially bound and update after bind, so slots can be written while the set is bound, as long as
+    // no submitted work uses them, which is why released slots are only reused after every frame slot came around once
+    // given a DescriptorBuffer the table lives in its persistent region instead of a pool, and buffers added to it need
+    // eShaderDeviceAddress
+    class BindlessTable {
+      public:
+        static constexpr u32 SET = 1;
+
+        static constexpr u32 IMAGE_BINDING   = 0;
+        static constexpr u32 SAMPLER_BINDING = 1;
+        static constexpr u32 BUFFER_BINDING  = 2;
+
+        // upper bounds, the device limits can shrink them further
+        static constexpr u32 MAX_IMAGES   = 16384;
+        static constexpr u32 MAX_SAMPLERS = 256;
+        static constexpr u32 MAX_BUFFERS  = 16384;
+
+      public:
+        explicit BindlessTable(const vk::Device& device);
+
+        void create(vk::PhysicalDevice physical_device, u32 frame_count, DescriptorBuffer* descriptor_buffer = nullptr);
+        void destroy();
+
+        // the caller must have waited on the fence guarding this slot
+        void begin_frame(u32 frame_slot);
+
+        // the returned index is what shaders use, the descriptor itself is only written on the next flush()
+        auto add_image(vk::ImageView view, vk::ImageLayout layout = vk::ImageLayout::eShaderReadOnlyOptimal) -> u32;
+        auto add_sampler(vk::Sampler sampler) -> u32;
+        // descriptor buffers can't describe VK_WHOLE_SIZE, so the range is always spelled out
+        auto add_buffer(vk::Buffer buffer, vk::DeviceSize offset, vk::DeviceSize range) -> u32;
+
+        void release_image(u32 index);
+        void release_sampler(u32 index);
+        void release_buffer(u32 index);
+
+        // writes everything added since the last flush in a single vkUpdateDescriptorSets, before the frame is submitted
+        void flush();
+
+        // any layout that came out of a PipelineLayoutCache the table was reserved in is compatible
+        // with a descriptor buffer, that buffer has to be bound to the command buffer already
+        void bind(vk::CommandBuffer cmd, vk::PipelineBindPoint bind_point, vk::PipelineLayout layout) const;
+
+        SYLK_NODISCARD auto layout() const -> vk::DescriptorSetLayout;
+        SYLK_NODISCARD auto valid() const -> bool;
+
+      private:
+        struct Slots {
+            u32                           capacity = 0;
+            u32                           next     = 0;
+            std::vector<u32>              free;
+            std::vector<std::vector<u32>> retired;  // indexed by the frame slot they were released in
+        };
+
+        auto claim(Slots& slots, const char* kind) -> u32;
+        void release(Slots& slots, u32 index) const;
+        void write_pending_to_buffer();
+
+      private:
+        const vk::Device&       device_;
+        vk::DescriptorSetLayout layout_;
+        vk::DescriptorPool      pool_;
+        vk::DescriptorSet       set_;
+        u32                     current_slot_;
+
+        DescriptorBuffer*            descriptor_buffer_ = nullptr;
+        DescriptorBuffer::Allocation allocation_;
+
+        Slots image_slots_;
+        Slots sampler_slots_;
+        Slots buffer_slots_;
+
+        std::vector<std::pair<u32, vk::DescriptorImageInfo>>  pending_images_;
+        std::vector<std::pair<u32, vk::DescriptorImageInfo>>  pending_samplers_;
+        std::vector<std::pair<u32, vk::DescriptorBufferInfo>> pending_buffers_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_DESCRIPTOR_BINDLESSTABLE_HPP
@@ -0,0 +1,75 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_DESCRIPTOR_DESCRIPTORALLOCATOR_HPP
+#define SYLK_VULKAN_DESCRIPTOR_DESCRIPTORALLOCATOR_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <span>
+#include <vector>
+
+namespace sylk {
+
+    // hands out descriptor sets from a growing list of pools, a new pool is created whenever the current one runs out
+    // sets are never freed individually: per frame sets go away in bulk when their slot comes around again, like the
+    // command allocator does with command buffers, persistent sets only once the allocator is destroyed
+    // not thread safe, sets are meant to be allocated on the render thread
+    class DescriptorAllocator {
+      public:
+        // how many descriptors of a type a pool holds per set it is sized for
+        struct PoolRatio {
+            vk::DescriptorType type;
+            f32                per_set;
+        };
+
+        static constexpr PoolRatio DEFAULT_RATIOS[] = {
+            {       vk::DescriptorType::eUniformBuffer, 1.0f},
+            {vk::DescriptorType::eCombinedImageSampler, 2.0f},
+            {       vk::DescriptorType::eStorageBuffer, 1.0f},
+            {        vk::DescriptorType::eStorageImage, 0.5f},
+        };
+
+      public:
+        explicit DescriptorAllocator(const vk::Device& device);
+
+        void create(u32 frame_count, std::span<const PoolRatio> ratios = DEFAULT_RATIOS);
+        void destroy();
+
+        // the caller must have waited on the fence guarding this slot, every set allocated for it is invalidated
+        void begin_frame(u32 frame_slot);
+
+        // only valid until the next begin_frame() of the current slot
+        auto allocate(vk::DescriptorSetLayout layout) -> vk::DescriptorSet;
+        // valid until destroy()
+        auto allocate_persistent(vk::DescriptorSetLayout layout) -> vk::DescriptorSet;
+
+        SYLK_NODISCARD auto pool_count() const -> u64;
+
+      private:
+        // pools with room left in ready, exhausted ones wait in full until they are reset
+        struct Arena {
+            std::vector<vk::DescriptorPool> ready;
+            std::vector<vk::DescriptorPool> full;
+            u32                             sets_per_pool;
+        };
+
+        auto allocate_from(Arena& arena, vk::DescriptorSetLayout layout) -> vk::DescriptorSet;
+        auto acquire_pool(Arena& arena) -> vk::DescriptorPool;
+        auto create_pool(u32 set_count) const -> vk::DescriptorPool;
+        void reset(Arena& arena) const;
+        void destroy(Arena& arena) const;
+
+      private:
+        const vk::Device&      device_;
+        std::vector<PoolRatio> ratios_;
+        std::vector<Arena>     frame_arenas_;
+        Arena                  persistent_arena_;
+        u32                    current_slot_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_DESCRIPTOR_DESCRIPTORALLOCATOR_HPP
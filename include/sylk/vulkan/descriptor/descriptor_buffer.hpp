@@ -0,0 +1,94 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_DESCRIPTOR_DESCRIPTORBUFFER_HPP
+#define SYLK_VULKAN_DESCRIPTOR_DESCRIPTORBUFFER_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/memory/buffer.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <map>
+#include <vector>
+
+namespace sylk {
+
+    // the VK_EXT_descriptor_buffer backend, descriptors are written straight into mapped gpu memory and bound by offset,
+    // so there are no pools, no set objects and no vkUpdateDescriptorSets, writing a descriptor is a memcpy
+    //
+    // everything lives in a single buffer, so binding it is one call per command buffer no matter how many sets are
+    // used, it's split into a linear region per frame slot that is reset in bulk, like the descriptor allocator does
+    // with its pools, and a persistent region at the end that is only ever released with the whole buffer
+    // every set layout used with it needs eDescriptorBufferEXT, and every pipeline eDescriptorBufferEXT as well
+    class DescriptorBuffer {
+      public:
+        // a set's worth of descriptors, offset is relative to the start of the buffer
+        struct Allocation {
+            vk::DeviceSize offset = 0;
+            u8*            data   = nullptr;
+
+            explicit operator bool() const {
+                return data != nullptr;
+            }
+        };
+
+      public:
+        explicit DescriptorBuffer(const vk::Device& device);
+
+        void create(vk::PhysicalDevice physical_device, u32 frame_count, vk::DeviceSize frame_size, vk::DeviceSize persistent_size);
+        void destroy();
+
+        // the caller must have waited on the fence guarding this slot, every allocation made for it is invalidated
+        void begin_frame(u32 frame_slot);
+
+        // only valid until the next begin_frame() of the current slot
+        auto allocate(vk::DescriptorSetLayout layout) -> Allocation;
+        // valid until destroy()
+        auto allocate_persistent(vk::DescriptorSetLayout layout) -> Allocation;
+
+        void write_buffer(const Allocation& allocation, vk::DescriptorSetLayout layout, u32 binding, vk::DescriptorType type,
+                          vk::DeviceAddress address, vk::DeviceSize range, u32 array_element = 0);
+        void write_image(const Allocation& allocation, vk::DescriptorSetLayout layout, u32 binding, vk::DescriptorType type,
+                         const vk::DescriptorImageInfo& image_info, u32 array_element = 0);
+
+        // has to happen once per command buffer before any set_offset()
+        void bind(vk::CommandBuffer cmd) const;
+        void set_offset(vk::CommandBuffer     cmd,
+                        vk::PipelineBindPoint bind_point,
+                        vk::PipelineLayout    layout,
+                        u32                   set,
+                        const Allocation&     allocation) const;
+
+        SYLK_NODISCARD auto valid() const -> bool;
+
+      private:
+        struct Region {
+            vk::DeviceSize begin;
+            vk::DeviceSize end;
+            vk::DeviceSize head;
+        };
+
+        auto allocate_from(Region& region, vk::DescriptorSetLayout layout) -> Allocation;
+        auto layout_size(vk::DescriptorSetLayout layout) -> vk::DeviceSize;
+        auto descriptor_size(vk::DescriptorType type) const -> u64;
+        void write(const Allocation& allocation, vk::DescriptorSetLayout layout, u32 binding, u32 array_element,
+                   const vk::DescriptorGetInfoEXT& get_info);
+
+      private:
+        const vk::Device&                               device_;
+        vk::PhysicalDeviceDescriptorBufferPropertiesEXT properties_;
+        Buffer                                          buffer_;
+        vk::DeviceAddress                               address_ = 0;
+        std::vector<Region>                             frame_regions_;
+        Region                                          persistent_region_ {};
+        u32                                             current_slot_;
+
+        // set layout sizes and binding offsets are fixed per layout, but asking the driver isn't free
+        std::map<VkDescriptorSetLayout, vk::DeviceSize>                  layout_sizes_;
+        std::map<std::pair<VkDescriptorSetLayout, u32>, vk::DeviceSize> binding_offsets_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_DESCRIPTOR_DESCRIPTORBUFFER_HPP
@@ -0,0 +1,68 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_DESCRIPTOR_DESCRIPTORTEMPLATE_HPP
+#define SYLK_VULKAN_DESCRIPTOR_DESCRIPTORTEMPLATE_HPP
+
+#include <sylk/core/utils/log.hpp>
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/pipeline/pipeline_layout_cache.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <type_traits>
+
+namespace sylk {
+
+    // writes a whole set from one packed struct through a VkDescriptorUpdateTemplate, instead of marshalling a
+    // WriteDescriptorSet per binding
+    // the struct holds the set's descriptors in binding order, a vk::DescriptorBufferInfo per buffer, a
+    // vk::DescriptorImageInfo per image or sampler and a vk::BufferView per texel buffer, arrays take one per element
+    //   struct FrameDescriptors {
+    //       vk::DescriptorBufferInfo uniforms;  // binding 0
+    //   };
+    class DescriptorTemplate {
+      public:
+        explicit DescriptorTemplate(const vk::Device& device);
+
+        // for sets that are allocated and updated, or pushed if the set is one of the layout cache's push sets
+        void create(const PipelineLayoutCache::Layout& layout,
+                    u32                                set,
+                    bool                               push,
+                    vk::PipelineBindPoint              bind_point = vk::PipelineBindPoint::eGraphics);
+        void destroy();
+
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        void update(const vk::DescriptorSet set, const T& descriptors) const {
+            if (matches(sizeof(T))) {
+                device_.updateDescriptorSetWithTemplate(set, template_, &descriptors);
+            }
+        }
+
+        // VK_KHR_push_descriptor, the descriptors are recorded into the command buffer and no set exists at all
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        void push(const vk::CommandBuffer cmd, const T& descriptors) const {
+            if (matches(sizeof(T))) {
+                cmd.pushDescriptorSetWithTemplateKHR(template_, pipeline_layout_, set_, &descriptors);
+            }
+        }
+
+        SYLK_NODISCARD auto data_size() const -> u64;
+        SYLK_NODISCARD auto valid() const -> bool;
+
+      private:
+        SYLK_NODISCARD auto matches(u64 size) const -> bool;
+
+      private:
+        const vk::Device&            device_;
+        vk::DescriptorUpdateTemplate template_;
+        vk::PipelineLayout           pipeline_layout_;
+        u32                          set_       = 0;
+        u64                          data_size_ = 0;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_DESCRIPTOR_DESCRIPTORTEMPLATE_HPP
@@ -23,11 +23,10 @@ namespace sylk {
         };
 
         struct CopyData {
-            vk::Buffer      target;
-            vk::DeviceSize  size;
-            vk::CommandPool pool;
-            vk::Device      device;
-            vk::Queue       queue;
+            vk::Buffer     target;
+            vk::DeviceSize size;
+            vk::DeviceSize src_offset = 0;
+            vk::DeviceSize dst_offset = 0;
         };
 
       public:
@@ -35,11 +34,14 @@ namespace sylk {
         void destroy_with(vk::Device device);
         void pass_data(void* data_to_pass, size_t size_in_bytes);
 
-        void copy_onto(CopyData data) const;
+        // only records the copy, submitting it is up to the owner of the command buffer
+        void copy_onto(vk::CommandBuffer cmd_buffer, CopyData data) const;
 
         SYLK_NODISCARD auto vk_buffer() const -> vk::Buffer;
         SYLK_NODISCARD auto memory_handle() const -> vk::DeviceMemory;
         SYLK_NODISCARD auto mapped_memory() const -> void*;
+        // the buffer has to have been created with eShaderDeviceAddress
+        SYLK_NODISCARD auto device_address(vk::Device device) const -> vk::DeviceAddress;
 
       private:
         SYLK_NODISCARD auto find_memtype(vk::PhysicalDevice physical_device, u32 type_filter, vk::MemoryPropertyFlags properties) -> u32;
@@ -0,0 +1,81 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_MEMORY_STREAMINGBUFFER_HPP
+#define SYLK_VULKAN_MEMORY_STREAMINGBUFFER_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/memory/buffer.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace sylk {
+
+    // a persistently mapped buffer for data the cpu rewrites every frame, instance streams and the like
+    // it's split into a linear region per frame slot, so writing the current frame never touches memory the gpu may
+    // still be reading for an earlier one, a region is reset in bulk once the fence of its slot has been waited on
+    // the memory is host visible and coherent, on most desktop gpus that's vram the cpu writes to over the bus, so
+    // writes should be sequential and the memory should never be read back
+    class StreamingBuffer {
+      public:
+        // offset is relative to the start of the buffer, which is what binds and descriptors want
+        struct Allocation {
+            vk::DeviceSize offset = 0;
+            u8*            data   = nullptr;
+
+            explicit operator bool() const {
+                return data != nullptr;
+            }
+        };
+
+      public:
+        explicit StreamingBuffer(const vk::Device& device);
+
+        void create(vk::PhysicalDevice physical_device, vk::BufferUsageFlags usage, u32 frame_count, vk::DeviceSize frame_size);
+        void destroy();
+
+        // the caller must have waited on the fence guarding this slot, every allocation made for it is invalidated
+        void begin_frame(u32 frame_slot);
+
+        // only valid until the next begin_frame() of the current slot, empty once the region is full
+        auto allocate(vk::DeviceSize size, vk::DeviceSize alignment = 16) -> Allocation;
+
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        auto write(const std::span<const T> elements) -> Allocation {
+            const auto allocation = allocate(elements.size_bytes(), alignof(T));
+            if (allocation) {
+                std::memcpy(allocation.data, elements.data(), elements.size_bytes());
+            }
+
+            return allocation;
+        }
+
+        SYLK_NODISCARD auto vk_buffer() const -> vk::Buffer;
+        SYLK_NODISCARD auto frame_size() const -> vk::DeviceSize;
+        SYLK_NODISCARD auto used() const -> vk::DeviceSize;  // of the current slot
+        SYLK_NODISCARD auto valid() const -> bool;
+
+      private:
+        struct Region {
+            vk::DeviceSize begin;
+            vk::DeviceSize end;
+            vk::DeviceSize head;
+        };
+
+      private:
+        const vk::Device&   device_;
+        Buffer              buffer_;
+        vk::DeviceSize      frame_size_ = 0;
+        std::vector<Region> frame_regions_;
+        u32                 current_slot_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_MEMORY_STREAMINGBUFFER_HPP
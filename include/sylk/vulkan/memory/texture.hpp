@@ -0,0 +1,48 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_MEMORY_TEXTURE_HPP
+#define SYLK_VULKAN_MEMORY_TEXTURE_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+namespace sylk {
+
+    // a sampled 2d image in device local memory, with a single mip level and the view shaders read it through
+    // its contents come from a staging buffer, after upload() it stays in eShaderReadOnlyOptimal for good
+    class Texture {
+      public:
+        struct CreateData {
+            const vk::Device          device;
+            const vk::PhysicalDevice  physical_device;
+            const vk::Extent2D        extent;
+            const vk::Format          format = vk::Format::eR8G8B8A8Srgb;
+            const vk::ImageUsageFlags usage  = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst;
+        };
+
+      public:
+        void create(CreateData data);
+        void destroy_with(vk::Device device);
+
+        // only records the copy and the transitions around it, submitting it is up to the owner of the command buffer
+        // the staging buffer holds tightly packed texels at the offset and has to live until the submission completes
+        void upload(vk::CommandBuffer cmd_buffer, vk::Buffer staging_buffer, vk::DeviceSize offset = 0) const;
+
+        SYLK_NODISCARD auto vk_image() const -> vk::Image;
+        SYLK_NODISCARD auto view() const -> vk::ImageView;
+        SYLK_NODISCARD auto extent() const -> vk::Extent2D;
+
+      private:
+        SYLK_NODISCARD auto find_memtype(vk::PhysicalDevice physical_device, u32 type_filter, vk::MemoryPropertyFlags properties) -> u32;
+
+      private:
+        vk::Image        image_;
+        vk::DeviceMemory image_memory_;
+        vk::ImageView    view_;
+        vk::Extent2D     extent_;
+    };
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_MEMORY_TEXTURE_HPP
@@ -0,0 +1,112 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_PIPELINE_COMPUTEPIPELINE_HPP
+#define SYLK_VULKAN_PIPELINE_COMPUTEPIPELINE_HPP
+
+#include <sylk/core/utils/log.hpp>
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/descriptor/descriptor_template.hpp>
+#include <sylk/vulkan/pipeline/pipeline_layout_cache.hpp>
+#include <sylk/vulkan/pipeline/push_constants.hpp>
+#include <sylk/vulkan/pipeline/specialization.hpp>
+#include <sylk/vulkan/shader/shader.hpp>
+#include <sylk/vulkan/shader/shader_reflection.hpp>
+#include <sylk/vulkan/utils/device_features.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <array>
+#include <map>
+#include <span>
+#include <type_traits>
+
+namespace sylk {
+
+    // a single compute shader and its pipeline, built from the same plumbing as the graphics pipelines
+    // the module comes from the ShaderModuleCache, the layout from the PipelineLayoutCache, so a compute shader that
+    // agrees with a graphics shader on a set shares its set layout and with that its descriptor sets
+    //
+    // storage buffers and images are written through an update template per set, in the packed struct layout of a
+    // DescriptorTemplate, storage_buffer() and storage_image() build the entries
+    //   struct CullDescriptors {
+    //       vk::DescriptorBufferInfo bounds;    // binding 0, readonly buffer
+    //       vk::DescriptorBufferInfo commands;  // binding 1, writeonly buffer
+    //   };
+    // with descriptor buffers there are no sets to write, DescriptorBuffer::write_* fills the set and
+    // DescriptorBuffer::set_offset binds it at vk::PipelineBindPoint::eCompute instead
+    class ComputePipeline {
+      public:
+        ComputePipeline(const vk::Device& device, ShaderModuleCache& shader_modules);
+
+        // compiles on the calling thread, compute pipelines are few and have no state combinations to fan out into
+        void create(std::span<const u32>      code,
+                    const ShaderReflection&   reflection,
+                    PipelineLayoutCache&      layouts,
+                    vk::PipelineCache         cache,
+                    const DeviceFeatures&     features,
+                    const SpecializationData& specialization = {});
+        void destroy();
+
+        void bind(vk::CommandBuffer cmd) const;
+        void bind_set(vk::CommandBuffer cmd, u32 set, vk::DescriptorSet descriptor_set) const;
+
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        void update(const u32 set, const vk::DescriptorSet descriptor_set, const T& descriptors) const {
+            if (const auto* descriptor_template = find_template(set)) {
+                descriptor_template->update(descriptor_set, descriptors);
+            }
+        }
+
+        // only for sets the layout cache was told to push, see PipelineLayoutCache::push_set()
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        void push(const vk::CommandBuffer cmd, const u32 set, const T& descriptors) const {
+            if (const auto* descriptor_template = find_template(set)) {
+                descriptor_template->push(cmd, descriptors);
+            }
+        }
+
+        template<typename T>
+        auto push_constants(const u32 offset = 0) const -> PushConstants<T> {
+            return PushConstants<T>(layout_, cached_layout_->push_constant_ranges, offset);
+        }
+
+        // counts are in workgroups, dispatch_invocations() rounds a number of invocations up to whole workgroups
+        void dispatch(vk::CommandBuffer cmd, u32 x, u32 y = 1, u32 z = 1) const;
+        void dispatch_invocations(vk::CommandBuffer cmd, u32 x, u32 y = 1, u32 z = 1) const;
+
+        // the buffer holds a vk::DispatchIndirectCommand at the offset and needs eIndirectBuffer usage
+        void dispatch_indirect(vk::CommandBuffer cmd, vk::Buffer buffer, vk::DeviceSize offset = 0) const;
+
+        // makes the shader writes of every dispatch recorded so far visible to the given stages
+        static void barrier(vk::CommandBuffer cmd, vk::PipelineStageFlags2 dst_stages, vk::AccessFlags2 dst_access);
+
+        static auto storage_buffer(vk::Buffer buffer, vk::DeviceSize offset = 0, vk::DeviceSize range = VK_WHOLE_SIZE)
+            -> vk::DescriptorBufferInfo;
+        // storage images are read and written in the general layout
+        static auto storage_image(vk::ImageView view) -> vk::DescriptorImageInfo;
+
+        SYLK_NODISCARD auto group_count(u32 x, u32 y = 1, u32 z = 1) const -> std::array<u32, 3>;
+        SYLK_NODISCARD auto local_size() const -> const std::array<u32, 3>&;
+        SYLK_NODISCARD auto get_handle() const -> vk::Pipeline;
+        SYLK_NODISCARD auto get_layout() const -> vk::PipelineLayout;
+        SYLK_NODISCARD auto cached_layout() const -> const PipelineLayoutCache::Layout&;
+
+      private:
+        SYLK_NODISCARD auto find_template(u32 set) const -> const DescriptorTemplate*;
+
+      private:
+        const vk::Device&                  device_;
+        vk::Pipeline                       pipeline_;
+        vk::PipelineLayout                 layout_;
+        const PipelineLayoutCache::Layout* cached_layout_ = nullptr;
+        std::array<u32, 3>                 local_size_    = {1, 1, 1};
+        std::map<u32, DescriptorTemplate>  templates_;
+        Shader                             shader_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_PIPELINE_COMPUTEPIPELINE_HPP
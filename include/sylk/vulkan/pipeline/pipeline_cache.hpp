@@ -0,0 +1,71 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_PIPELINE_PIPELINECACHE_HPP
+#define SYLK_VULKAN_PIPELINE_PIPELINECACHE_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+namespace sylk {
+
+    // VkPipelineCache that survives between runs
+    // the file is only trusted when it was written by the same device, driver and cache layout, anything else starts cold
+    class PipelineCache {
+      public:
+        explicit PipelineCache(const vk::Device& device);
+
+        void create(vk::PhysicalDevice physical_device, std::filesystem::path path);
+        void destroy();  // writes the cache back before destroying it
+
+        void save();
+        // only writes anything if pipelines were compiled since the last save, safe to call from any single thread
+        void save_if_changed();
+
+        // true at most once per interval and never while the previous save hasn't finished, which the caller then
+        // has to start with save_if_changed()
+        SYLK_NODISCARD auto save_due(std::chrono::seconds interval) -> bool;
+
+        SYLK_NODISCARD auto was_warm() const -> bool;
+        SYLK_NODISCARD auto get_handle() const -> vk::PipelineCache;
+
+      private:
+        struct FileHeader {
+            u32                          magic;
+            u32                          version;
+            u32                          vendor_id;
+            u32                          device_id;
+            u32                          driver_version;
+            u32                          reserved;
+            std::array<u8, VK_UUID_SIZE> device_uuid;
+            std::array<u8, VK_UUID_SIZE> cache_uuid;
+            u64                          data_size;
+            u64                          data_hash;
+        };
+
+        SYLK_NODISCARD auto load() const -> std::vector<u8>;
+        SYLK_NODISCARD auto matches_device(const FileHeader& header) const -> bool;
+        SYLK_NODISCARD auto matches_driver_header(const std::vector<u8>& data) const -> bool;
+
+      private:
+        const vk::Device&     device_;
+        vk::PipelineCache     cache_;
+        std::filesystem::path path_;
+        FileHeader            expected_header_;
+        bool                  warm_;
+        u64                   last_saved_size_;
+
+        std::atomic<bool>                     saving_;
+        std::chrono::steady_clock::time_point last_save_time_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_PIPELINE_PIPELINECACHE_HPP
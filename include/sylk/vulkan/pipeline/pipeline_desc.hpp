@@ -0,0 +1,77 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_PIPELINE_PIPELINEDESC_HPP
+#define SYLK_VULKAN_PIPELINE_PIPELINEDESC_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/pipeline/specialization.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <vector>
+
+namespace sylk {
+
+    enum class EBlendMode : u8 {
+        NONE,
+        ALPHA,
+        ADDITIVE,
+    };
+
+    SYLK_NODISCARD auto blend_enabled(EBlendMode mode) -> bool;
+    SYLK_NODISCARD auto blend_equation(EBlendMode mode) -> vk::ColorBlendEquationEXT;
+
+    // state that is set while recording instead of being baked into the pipeline
+    // blending is only dynamic where VK_EXT_extended_dynamic_state3 is supported, elsewhere it stays part of the pipeline
+    struct RenderState {
+        vk::PrimitiveTopology topology      = vk::PrimitiveTopology::eTriangleList;
+        vk::CullModeFlags     cull_mode     = vk::CullModeFlagBits::eNone;
+        vk::FrontFace         front_face    = vk::FrontFace::eCounterClockwise;
+        bool                  depth_test    = false;
+        bool                  depth_write   = false;
+        vk::CompareOp         depth_compare = vk::CompareOp::eLess;
+        EBlendMode            blend         = EBlendMode::ALPHA;
+
+        auto operator==(const RenderState&) const -> bool = default;
+    };
+
+    // refers to a pipeline owned by a PipelineLibrary, a zero key means "no pipeline"
+    struct PipelineHandle {
+        u64 key = 0;
+
+        explicit operator bool() const { return key != 0; }
+        auto     operator==(const PipelineHandle&) const -> bool = default;
+    };
+
+    // the full state a graphics pipeline is built from, two equal descriptions always produce interchangeable pipelines
+    struct PipelineDesc {
+        vk::ShaderModule   vertex_shader;
+        vk::ShaderModule   fragment_shader;
+        SpecializationData vertex_specialization;
+        SpecializationData fragment_specialization;
+        vk::PipelineLayout layout;
+        vk::RenderPass     renderpass;
+        u32                subpass = 0;
+
+        std::vector<vk::VertexInputBindingDescription>   vertex_bindings;
+        std::vector<vk::VertexInputAttributeDescription> vertex_attributes;
+
+        vk::PolygonMode polygon_mode = vk::PolygonMode::eFill;
+        RenderState     state {};
+
+        SYLK_NODISCARD auto hash() const -> u64;
+
+        // the state each graphics pipeline library part is built from, see VK_EXT_graphics_pipeline_library
+        // descriptions that share a part hash can share the compiled part
+        SYLK_NODISCARD auto vertex_input_hash() const -> u64;
+        SYLK_NODISCARD auto pre_rasterization_hash() const -> u64;
+        SYLK_NODISCARD auto fragment_shader_hash() const -> u64;
+        SYLK_NODISCARD auto fragment_output_hash() const -> u64;
+
+        auto operator==(const PipelineDesc&) const -> bool = default;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_PIPELINE_PIPELINEDESC_HPP
@@ -0,0 +1,87 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_PIPELINE_PIPELINELAYOUTCACHE_HPP
+#define SYLK_VULKAN_PIPELINE_PIPELINELAYOUTCACHE_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/shader/shader_reflection.hpp>
+#include <sylk/vulkan/utils/constants.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <span>
+#include <tuple>
+#include <vector>
+
+namespace sylk {
+
+    // builds pipeline layouts from the reflection of a pipeline's stages
+    // identical descriptor set layouts and pipeline layouts are only ever created once, so shaders that agree on their
+    // bindings also share layouts, and with that the descriptor sets allocated for them
+    // layouts are meant to be created up front on the render thread, this is not thread safe
+    class PipelineLayoutCache {
+      public:
+        struct Layout {
+            vk::PipelineLayout                   pipeline_layout;
+            std::vector<vk::DescriptorSetLayout> set_layouts;  // indexed by set, sets without bindings get an empty layout
+            std::vector<vk::PushConstantRange>   push_constant_ranges;
+
+            // indexed by set like set_layouts, empty for reserved sets, this is what update templates are built from
+            std::vector<std::vector<vk::DescriptorSetLayoutBinding>> set_bindings;
+        };
+
+      public:
+        explicit PipelineLayoutCache(const vk::Device& device);
+
+        // the flags go onto every set layout the cache creates, eDescriptorBufferEXT when descriptors live in buffers
+        void create(vk::PhysicalDevice physical_device, vk::DescriptorSetLayoutCreateFlags set_layout_flags = {});
+        void destroy();
+
+        // every layout gets this set layout at the given set, whether its shaders use the set or not, the reflected
+        // bindings of that set are trusted to match, this has to happen before the first get()
+        void reserve_set(u32 set, vk::DescriptorSetLayout set_layout);
+
+        // the layout of this set is created with ePushDescriptorKHR in every layout, so it is pushed instead of allocated
+        // this has to happen before the first get() as well
+        void push_set(u32 set);
+
+        // the reference stays valid until destroy()
+        auto get(std::span<const ShaderReflection* const> stages) -> const Layout&;
+
+        // the cached layout a pipeline layout handle was created for, null if it didn't come from this cache
+        SYLK_NODISCARD auto find(vk::PipelineLayout pipeline_layout) const -> const Layout*;
+        SYLK_NODISCARD auto is_push_set(u32 set) const -> bool;
+
+        SYLK_NODISCARD auto layout_count() const -> u64;
+        SYLK_NODISCARD auto set_layout_count() const -> u64;
+
+      private:
+        using BindingKey      = std::tuple<u32, vk::DescriptorType, u32, VkShaderStageFlags>;
+        using PushConstantKey = std::tuple<u32, u32, VkShaderStageFlags>;
+        using LayoutKey       = std::tuple<std::vector<VkDescriptorSetLayout>, std::vector<PushConstantKey>>;
+        using SetLayoutKey    = std::pair<VkDescriptorSetLayoutCreateFlags, std::vector<BindingKey>>;
+
+        auto get_set_layout(const std::vector<BindingKey>& bindings, vk::DescriptorSetLayoutCreateFlags flags)
+            -> vk::DescriptorSetLayout;
+
+        static auto to_layout_bindings(const std::vector<BindingKey>& bindings) -> std::vector<vk::DescriptorSetLayoutBinding>;
+
+      private:
+        const vk::Device& device_;
+        u32               max_push_constants_size_ = GUARANTEED_PUSH_CONSTANTS_SIZE;
+
+        vk::DescriptorSetLayoutCreateFlags set_layout_flags_;
+
+        std::map<u32, vk::DescriptorSetLayout>          reserved_sets_;
+        std::set<u32>                                   push_sets_;
+        std::map<SetLayoutKey, vk::DescriptorSetLayout> set_layouts_;
+        std::map<LayoutKey, std::unique_ptr<Layout>>    layouts_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_PIPELINE_PIPELINELAYOUTCACHE_HPP
@@ -0,0 +1,160 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_PIPELINE_PIPELINELIBRARY_HPP
+#define SYLK_VULKAN_PIPELINE_PIPELINELIBRARY_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/pipeline/pipeline_desc.hpp>
+#include <sylk/vulkan/utils/device_features.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace sylk {
+    class PipelineCache;
+
+    // owns every graphics pipeline, keyed by the hash of its description
+    // requesting a description that was seen before hands back the same pipeline, new ones are compiled on worker
+    // threads so the render thread never has to wait on the driver
+    //
+    // with VK_EXT_graphics_pipeline_library every pipeline is split into four parts that are compiled once and shared
+    // between descriptions, a new pipeline is then a fast link of existing parts and the optimized link replaces it
+    // in the background whenever a worker gets around to it
+    //
+    // the RenderState of a description is dynamic, it's normalized away before hashing so descriptions that only differ
+    // there share one pipeline, the actual values are set per draw with a DynamicStateTracker
+    class PipelineLibrary {
+      public:
+        enum class EState : u8 {
+            QUEUED,
+            COMPILING,
+            READY,
+            FAILED,
+        };
+
+      public:
+        explicit PipelineLibrary(const vk::Device& device);
+
+        void create(vk::PipelineCache cache, u32 worker_count, u32 frames_in_flight, const DeviceFeatures& features);
+        void destroy();
+
+        // returns immediately, the pipeline becomes available once a worker has compiled it
+        auto request(const PipelineDesc& desc) -> PipelineHandle;
+
+        // compiles on the calling thread if nobody has started on it yet, meant for loading screens and fallbacks
+        auto request_blocking(const PipelineDesc& desc) -> PipelineHandle;
+
+        // every pipeline built from `from` is rebuilt with `to` in the background, as are pipelines requested later on
+        // handles stay the same, the rebuilt pipelines only replace the old ones in swap_reloaded(), so a frame never
+        // sees half of a reload, returns how many pipelines are being rebuilt
+        auto replace_module(vk::ShaderModule from, vk::ShaderModule to) -> u32;
+
+        // meant to be called between frames, returns how many pipelines were swapped
+        auto swap_reloaded() -> u32;
+
+        // call once per frame after waiting on its fence, frees the pipelines replaced at least frames_in_flight ago
+        void begin_frame();
+
+        // runs cache.save_if_changed() on a worker, so the render thread never waits on the driver serializing it
+        void save_cache(PipelineCache& cache);
+
+        // null until the pipeline is ready, in which case the fallback is tried instead
+        SYLK_NODISCARD auto resolve(PipelineHandle handle, PipelineHandle fallback = {}) const -> vk::Pipeline;
+        SYLK_NODISCARD auto state(PipelineHandle handle) const -> EState;
+        SYLK_NODISCARD auto pending_count() const -> u64;
+        SYLK_NODISCARD auto dynamic_blend() const -> bool;
+
+      private:
+        enum class EPart : u8 {
+            VERTEX_INPUT,
+            PRE_RASTERIZATION,
+            FRAGMENT_SHADER,
+            FRAGMENT_OUTPUT,
+        };
+
+        struct Entry {
+            PipelineDesc              desc;
+            std::atomic<vk::Pipeline> pipeline;
+            std::atomic<EState>       state {EState::QUEUED};
+
+            // guarded by the mutex, a generation passes whenever a reloaded pipeline is swapped in
+            u32 generation    = 0;
+            u32 reload_ticket = 0;
+        };
+
+        // an optimize job swaps the entry's fast-linked pipeline for a link-time optimized one
+        // a reload job builds the entry again with the current module replacements, only the latest ticket is kept
+        // a save job has no entry, it writes the pipeline cache back
+        struct Job {
+            Entry*         entry    = nullptr;
+            bool           optimize = false;
+            bool           reload   = false;
+            u32            ticket   = 0;
+            PipelineCache* cache    = nullptr;
+        };
+
+        // a replaced pipeline, tagged with the frame it was replaced in
+        struct Retired {
+            vk::Pipeline pipeline;
+            u64          frame = 0;
+        };
+
+        struct Reloaded {
+            Entry*       entry = nullptr;
+            vk::Pipeline pipeline;
+            u32          ticket = 0;
+        };
+
+        SYLK_NODISCARD auto normalize(const PipelineDesc& desc) const -> PipelineDesc;
+
+        // the entry's description with every module replacement applied, and the generation that belongs to it
+        auto current_desc(const Entry& entry) const -> std::pair<PipelineDesc, u32>;
+        auto replaced(vk::ShaderModule module) const -> vk::ShaderModule;
+
+        auto find_or_insert(const PipelineDesc& desc, bool& inserted) -> std::pair<u64, Entry*>;
+        auto find(PipelineHandle handle) const -> const Entry*;
+        void compile_entry(Entry& entry);
+        void optimize_entry(Entry& entry);
+        void reload_entry(Entry& entry, u32 ticket);
+        void push_job(Job job);
+        void work(const std::stop_token& stop_token);
+
+        SYLK_NODISCARD auto compile(const PipelineDesc& desc) const -> vk::Pipeline;
+        SYLK_NODISCARD auto compile_part(EPart part, const PipelineDesc& desc) const -> vk::Pipeline;
+        SYLK_NODISCARD auto link(const PipelineDesc& desc, bool optimize) -> vk::Pipeline;
+        SYLK_NODISCARD auto get_part(EPart part, const PipelineDesc& desc) -> vk::Pipeline;
+
+      private:
+        const vk::Device& device_;
+        vk::PipelineCache cache_;
+        bool              use_part_libraries_ = false;
+        bool              dynamic_blend_      = false;
+        u32               frames_in_flight_   = 0;
+
+        // flags every pipeline and part is created with, on top of whatever its kind needs
+        vk::PipelineCreateFlags base_flags_;
+
+        mutable std::mutex                                   mutex_;
+        std::condition_variable_any                          queue_signal_;
+        std::deque<Job>                                      queue_;
+        std::unordered_map<u64, std::unique_ptr<Entry>>      entries_;
+        std::unordered_map<u64, vk::Pipeline>                parts_;
+        std::vector<Retired>                                 retired_;
+        std::unordered_map<VkShaderModule, vk::ShaderModule> replacements_;
+        std::vector<Reloaded>                                reloaded_;
+        std::vector<std::jthread>                            workers_;
+        u64                                                  frame_ = 0;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_PIPELINE_PIPELINELIBRARY_HPP
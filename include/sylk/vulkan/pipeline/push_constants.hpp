@@ -0,0 +1,70 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_PIPELINE_PUSHCONSTANTS_HPP
+#define SYLK_VULKAN_PIPELINE_PUSHCONSTANTS_HPP
+
+#include <sylk/core/utils/log.hpp>
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/utils/constants.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <span>
+#include <type_traits>
+
+namespace sylk {
+
+    // a typed slice of a pipeline layout's push constant ranges
+    // the stage flags are worked out once from the layout, vkCmdPushConstants wants every stage whose range overlaps
+    // the update, and every one of those ranges has to cover all of it
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    class PushConstants {
+        static_assert(sizeof(T) % 4 == 0, "Push constant updates have to be a multiple of 4 bytes");
+        static_assert(sizeof(T) <= GUARANTEED_PUSH_CONSTANTS_SIZE, "Push constants this large aren't supported everywhere");
+
+      public:
+        PushConstants() = default;
+
+        PushConstants(const vk::PipelineLayout layout, const std::span<const vk::PushConstantRange> ranges, const u32 offset = 0)
+            : layout_(layout)
+            , offset_(offset) {
+            const u32 end = offset + sizeof(T);
+
+            for (const auto& range : ranges) {
+                if (range.offset >= end || range.offset + range.size <= offset) {
+                    continue;
+                }
+
+                if (range.offset > offset || range.offset + range.size < end) {
+                    log(ELogLvl::ERROR, "Push constant range [{}, {}) only partially covers the update", range.offset, range.offset + range.size);
+                    stages_ = {};
+                    return;
+                }
+
+                stages_ |= range.stageFlags;
+            }
+
+            if (!stages_) {
+                log(ELogLvl::ERROR, "Pipeline layout has no push constants at offset {}", offset);
+            }
+        }
+
+        void push(const vk::CommandBuffer cmd, const T& value) const {
+            cmd.pushConstants(layout_, stages_, offset_, sizeof(T), &value);
+        }
+
+        explicit operator bool() const {
+            return static_cast<bool>(stages_);
+        }
+
+      private:
+        vk::PipelineLayout   layout_;
+        vk::ShaderStageFlags stages_;
+        u32                  offset_ = 0;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_PIPELINE_PUSHCONSTANTS_HPP
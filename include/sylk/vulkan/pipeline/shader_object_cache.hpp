@@ -0,0 +1,79 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_PIPELINE_SHADEROBJECTCACHE_HPP
+#define SYLK_VULKAN_PIPELINE_SHADEROBJECTCACHE_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/pipeline/pipeline_desc.hpp>
+#include <sylk/vulkan/pipeline/pipeline_layout_cache.hpp>
+#include <sylk/vulkan/shader/shader_module_cache.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace sylk {
+
+    // the pipeline-free alternative to the PipelineLibrary, built on VK_EXT_shader_object
+    // every stage is compiled on its own, once per module, specialization and layout, and stages are bound independently
+    // so there is no such thing as a state combination that still has to be compiled, everything a pipeline would have
+    // baked in is set while recording instead
+    // handles are requested from here rather than from the library while shader objects are in use
+    // meant for the render thread, this is not thread safe
+    class ShaderObjectCache {
+      public:
+        // what a draw binds in place of a pipeline
+        struct Program {
+            vk::ShaderEXT   vertex;
+            vk::ShaderEXT   fragment;
+            vk::PolygonMode polygon_mode = vk::PolygonMode::eFill;
+
+            std::vector<vk::VertexInputBindingDescription2EXT>   vertex_bindings;
+            std::vector<vk::VertexInputAttributeDescription2EXT> vertex_attributes;
+
+            void bind(vk::CommandBuffer cmd) const;
+        };
+
+      public:
+        ShaderObjectCache(const vk::Device& device, const ShaderModuleCache& shader_modules, const PipelineLayoutCache& layouts);
+
+        void destroy();
+
+        // compiles whichever stages of the description haven't been seen before, on the calling thread
+        // the renderpass and the RenderState of the description don't matter, neither exists until recording
+        auto request(const PipelineDesc& desc) -> PipelineHandle;
+
+        // rebuilds the stages of every program that uses `from` with `to` on the calling thread, the programs are
+        // updated in place so this has to happen between frames, returns how many programs were rebuilt
+        auto replace_module(vk::ShaderModule from, vk::ShaderModule to) -> u32;
+
+        SYLK_NODISCARD auto resolve(PipelineHandle handle, PipelineHandle fallback = {}) const -> const Program*;
+        SYLK_NODISCARD auto shader_count() const -> u64;
+
+        // undefined at the start of every command buffer, and nothing else sets it while shader objects are bound
+        // the RenderState part is left to a DynamicStateTracker
+        static void set_fixed_state(vk::CommandBuffer cmd, vk::Extent2D extent);
+
+      private:
+        auto get_shader(vk::ShaderStageFlagBits            stage,
+                        vk::ShaderStageFlags               next_stage,
+                        vk::ShaderModule                   module,
+                        const SpecializationData&          specialization,
+                        const PipelineLayoutCache::Layout& layout) -> vk::ShaderEXT;
+
+      private:
+        const vk::Device&          device_;
+        const ShaderModuleCache&   shader_modules_;
+        const PipelineLayoutCache& layouts_;
+
+        std::unordered_map<u64, vk::ShaderEXT>            shaders_;
+        std::unordered_map<u64, std::unique_ptr<Program>> programs_;
+        std::unordered_map<u64, PipelineDesc>             descs_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_PIPELINE_SHADEROBJECTCACHE_HPP
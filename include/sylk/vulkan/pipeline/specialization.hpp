@@ -0,0 +1,133 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_PIPELINE_SPECIALIZATION_HPP
+#define SYLK_VULKAN_PIPELINE_SPECIALIZATION_HPP
+
+#include <sylk/core/utils/cast.hpp>
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/shader/shader_reflection.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <concepts>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace sylk {
+
+    // a single `layout(constant_id = Id) const T` in glsl
+    template<u32 Id, typename T>
+        requires(std::same_as<T, bool> || std::same_as<T, i32> || std::same_as<T, u32> || std::same_as<T, f32>)
+    struct SpecConstant {
+        static constexpr u32 id = Id;
+        using value_type        = T;
+
+        T value;
+    };
+
+    // the type erased constants of a single stage, as they end up in a PipelineDesc
+    struct SpecializationData {
+        std::vector<vk::SpecializationMapEntry> entries;
+        std::vector<u8>                         data;
+
+        SYLK_NODISCARD auto empty() const -> bool;
+        SYLK_NODISCARD auto hash() const -> u64;
+
+        // points into this object, so it has to outlive the returned info
+        SYLK_NODISCARD auto info() const -> vk::SpecializationInfo;
+
+        auto operator==(const SpecializationData&) const -> bool = default;
+    };
+
+    namespace detail {
+        // glsl booleans are 32 bits wide
+        template<typename T>
+        using spec_storage_t = std::conditional_t<std::same_as<T, bool>, vk::Bool32, T>;
+
+        template<typename T>
+        inline constexpr ESpecConstantType spec_type_v = (std::same_as<T, bool>  ? ESpecConstantType::BOOL
+                                                          : std::same_as<T, i32> ? ESpecConstantType::INT
+                                                          : std::same_as<T, u32> ? ESpecConstantType::UINT
+                                                                                 : ESpecConstantType::FLOAT);
+
+        consteval auto reflected_spec_size(const ShaderReflection& reflection, const u32 id) -> u32 {
+            for (const auto& constant : reflection.spec_constants) {
+                if (constant.id == id) {
+                    return constant.size;
+                }
+            }
+
+            return 0;
+        }
+
+        // only meaningful for ids that exist, reflected_spec_size() checks for that first
+        template<typename T>
+        consteval auto reflected_spec_matches(const ShaderReflection& reflection, const u32 id) -> bool {
+            for (const auto& constant : reflection.spec_constants) {
+                if (constant.id == id) {
+                    return constant.type == spec_type_v<T> && constant.size == sizeof(spec_storage_t<T>);
+                }
+            }
+
+            return false;
+        }
+
+        template<u32... Ids>
+        consteval auto unique_spec_ids() -> bool {
+            constexpr u32 ids[] = {Ids..., 0};
+            for (u32 i = 0; i < sizeof...(Ids); ++i) {
+                for (u32 j = i + 1; j < sizeof...(Ids); ++j) {
+                    if (ids[i] == ids[j]) {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+    }  // namespace detail
+
+    // a typed set of constants for the shader described by Reflection, every id is checked against the shader at
+    // compile time, so renaming or retyping a constant in glsl breaks the build instead of silently doing nothing
+    //   SpecializationSet<SHADER_FRAG_REFLECTION, SpecConstant<0, u32>, SpecConstant<1, bool>> set({4}, {true});
+    template<const ShaderReflection& Reflection, typename... Constants>
+    class SpecializationSet {
+        static_assert(detail::unique_spec_ids<Constants::id...>(), "Specialization constant ids have to be unique");
+        static_assert(((detail::reflected_spec_size(Reflection, Constants::id) != 0) && ...),
+                      "Shader has no specialization constant with this id");
+        static_assert((detail::reflected_spec_matches<typename Constants::value_type>(Reflection, Constants::id) && ...),
+                      "Specialization constant type doesn't match the shader");
+
+      public:
+        constexpr explicit SpecializationSet(Constants... constants)
+            : constants_(constants...) {}
+
+        SYLK_NODISCARD auto data() const -> SpecializationData {
+            SpecializationData packed;
+
+            const auto append = [&packed]<typename Constant>(const Constant& constant) {
+                using Storage = detail::spec_storage_t<typename Constant::value_type>;
+
+                const auto value  = static_cast<Storage>(constant.value);
+                const auto offset = cast<u32>(packed.data.size());
+
+                packed.data.resize(offset + sizeof(Storage));
+                std::memcpy(packed.data.data() + offset, &value, sizeof(Storage));
+                packed.entries.push_back({.constantID = Constant::id, .offset = offset, .size = sizeof(Storage)});
+            };
+
+            std::apply([&append](const auto&... constants) { (append(constants), ...); }, constants_);
+
+            return packed;
+        }
+
+      private:
+        std::tuple<Constants...> constants_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_PIPELINE_SPECIALIZATION_HPP
@@ -0,0 +1,43 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_RENDER_DRAWPACKET_HPP
+#define SYLK_VULKAN_RENDER_DRAWPACKET_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/pipeline/pipeline_desc.hpp>
+
+namespace sylk {
+
+    // passes are recorded in the order they're declared in
+    enum class EDrawPass : u8 {
+        OPAQUE,       // front to back, grouped by pipeline and material
+        TRANSPARENT,  // back to front, so blending composes correctly, grouping only breaks ties in depth
+    };
+
+    // what recording walks instead of the draw list itself, payload is the index of the draw in the list
+    // sorting 16 byte packets moves a lot less memory than sorting whole draws
+    struct DrawPacket {
+        u64 key;
+        u32 payload;
+    };
+
+    // the inputs of a sort key, most significant first, in the order the key compares them
+    //   opaque:       pass:4 | layer:8 | pipeline:16 | material:16 | depth:20
+    //   transparent:  pass:4 | layer:8 | far to near depth:20 | pipeline:16 | material:16
+    // pipeline and material are folded down to 16 bits, two of them sharing their bits only costs a bind now and then
+    // depth is expected in [0, 1] with 0 nearest, anything outside is clamped
+    struct DrawKeyInputs {
+        EDrawPass      pass     = EDrawPass::OPAQUE;
+        u8             layer    = 0;
+        PipelineHandle pipeline = {};
+        u32            material = 0;
+        f32            depth    = 0.0f;
+    };
+
+    SYLK_NODISCARD auto make_draw_key(const DrawKeyInputs& inputs) -> u64;
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_RENDER_DRAWPACKET_HPP
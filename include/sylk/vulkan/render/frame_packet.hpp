@@ -0,0 +1,82 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_RENDER_FRAMEPACKET_HPP
+#define SYLK_VULKAN_RENDER_FRAMEPACKET_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/pipeline/pipeline_desc.hpp>
+#include <sylk/vulkan/render/draw_packet.hpp>
+#include <sylk/vulkan/render/sprite.hpp>
+#include <sylk/vulkan/shader/draw_constants.hpp>
+#include <sylk/vulkan/shader/instance_data.hpp>
+#include <sylk/vulkan/shader/uniformbuffer.hpp>
+
+#include <glm/mat4x4.hpp>
+
+#include <span>
+#include <vector>
+
+namespace sylk {
+
+    struct DrawCommand {
+        u32 index_count;
+        u32 first_index    = 0;
+        i32 vertex_offset  = 0;
+        u32 instance_count = 1;
+
+        // instanced draws read instance_count entries of FramePacket::instances, starting at first_instance
+        // an empty handle draws them with GraphicsPipeline::instanced_handle(), variants start from instanced_desc()
+        bool instanced      = false;
+        u32  first_instance = 0;
+
+        // an empty handle draws with the default pipeline, which is also used while this one is still compiling
+        // unless the draw would rather be skipped than drawn with the wrong state
+        PipelineHandle pipeline {};
+        bool           skip_until_ready = false;
+
+        // draws are recorded sorted by pass, layer, pipeline and material, and by depth within those, see
+        // make_draw_key(), draws that compare equal keep the order they were submitted in
+        EDrawPass pass  = EDrawPass::OPAQUE;
+        u8        layer = 0;
+        f32       depth = 0.0f;  // [0, 1], 0 nearest
+
+        // set at record time, so it doesn't need a pipeline of its own
+        RenderState state {};
+
+        // pushed right before the draw, small enough to never touch a buffer or a descriptor
+        DrawConstants constants {};
+    };
+
+    // everything the cpu side produces for a single frame
+    // it never references gpu memory directly, so it can be filled while the gpu is still busy with earlier frames
+    struct FramePacket {
+        u64                       frame_number = 0;
+        f32                       delta_time   = 0.0f;
+        f32                       elapsed_time = 0.0f;
+        UniformBufferObject       ubo {};
+        std::vector<DrawCommand>  draws;
+        std::vector<InstanceData> instances;
+
+        // drawn on top of the draws, sorted into as few instanced draws as their layers and images allow
+        std::vector<Sprite> sprites;
+
+        // the objects of the GpuScene outlive the packet, only the camera they're culled and drawn with is per frame
+        // it's kept from one frame to the next until it's set again
+        glm::mat4 scene_view_projection {1.0f};
+
+        // every copy of the mesh described by draw in a single draw call, one per entry of instances
+        void draw_instanced(DrawCommand draw, const std::span<const InstanceData> instances_to_draw) {
+            draw.instanced      = true;
+            draw.first_instance = static_cast<u32>(instances.size());
+            draw.instance_count = static_cast<u32>(instances_to_draw.size());
+
+            instances.insert(instances.end(), instances_to_draw.begin(), instances_to_draw.end());
+            draws.push_back(draw);
+        }
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_RENDER_FRAMEPACKET_HPP
@@ -0,0 +1,131 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_RENDER_GPUSCENE_HPP
+#define SYLK_VULKAN_RENDER_GPUSCENE_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/command/command_encoder.hpp>
+#include <sylk/vulkan/descriptor/descriptor_allocator.hpp>
+#include <sylk/vulkan/descriptor/descriptor_buffer.hpp>
+#include <sylk/vulkan/descriptor/descriptor_template.hpp>
+#include <sylk/vulkan/memory/buffer.hpp>
+#include <sylk/vulkan/memory/streaming_buffer.hpp>
+#include <sylk/vulkan/pipeline/compute_pipeline.hpp>
+#include <sylk/vulkan/pipeline/pipeline_desc.hpp>
+#include <sylk/vulkan/pipeline/pipeline_layout_cache.hpp>
+#include <sylk/vulkan/pipeline/push_constants.hpp>
+#include <sylk/vulkan/shader/draw_constants.hpp>
+#include <sylk/vulkan/shader/gpu_object.hpp>
+#include <sylk/vulkan/shader/shader.hpp>
+#include <sylk/vulkan/utils/device_features.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <glm/mat4x4.hpp>
+
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace sylk {
+
+    // objects that live on the gpu and are culled and drawn there, the cpu only touches the ones that change
+    // every object is a GpuObject in a device local storage buffer, cull.comp tests their bounds against the frustum
+    // and appends a VkDrawIndexedIndirectCommand for each one that's visible, the whole scene is then drawn with a
+    // single vkCmdDrawIndexedIndirectCount, so recording costs the same for ten objects as for a few hundred thousand
+    //
+    // changes are copied over from a StreamingBuffer at the start of the next frame, as many as fit its frame region,
+    // anything beyond that goes out with the frames after, the objects of a scene share the vertex and index buffers
+    // bound for the frame, see scene.vert
+    class GpuScene {
+      public:
+        // the set both shaders read the scene from, past the frame set and the bindless table
+        static constexpr u32 SET = 2;
+
+      public:
+        GpuScene(const vk::Device& device, ShaderModuleCache& shader_modules);
+
+        // the draw pipeline has to share sets 0 and 1 and the push constants with base, so the frame's sets stay bound
+        // given a DescriptorBuffer the sets live in it and the allocator isn't used
+        void create(vk::PhysicalDevice    physical_device,
+                    u32                   frame_count,
+                    u32                   capacity,
+                    PipelineLayoutCache&  layouts,
+                    vk::PipelineCache     cache,
+                    const DeviceFeatures& features,
+                    DescriptorAllocator&  descriptor_allocator,
+                    DescriptorBuffer*     descriptor_buffer,
+                    const PipelineDesc&   base);
+        void destroy();
+
+        // the owner requests desc() from the PipelineLibrary or the ShaderObjectCache and hands the handle back
+        void set_handle(PipelineHandle handle);
+
+        // same contract as GraphicsPipeline::reload_shader(), cull.comp isn't reloaded
+        auto reload_shader(std::string_view source_name, std::span<const u32> code) -> std::pair<vk::ShaderModule, vk::ShaderModule>;
+
+        // ids are stable until remove(), which frees them for the next add()
+        auto add(const GpuObject& object) -> u32;
+        void update(u32 id, const GpuObject& object);
+        void remove(u32 id);
+
+        // the caller must have waited on the fence guarding this slot
+        void begin_frame(u32 frame_slot);
+
+        // uploads what changed and culls against the frustum of view_projection, outside of any render pass
+        // with a descriptor buffer, that buffer has to be bound to the command buffer already
+        void cull(CommandEncoder& encoder, const glm::mat4& view_projection);
+        // draws whatever the last cull() left visible, the pipeline, the render state and the frame's sets have to be
+        // bound already, as do the vertex and index buffers the objects refer to
+        void record(CommandEncoder& encoder, const PushConstants<DrawConstants>& draw_constants) const;
+
+        SYLK_NODISCARD auto desc() const -> const PipelineDesc&;
+        SYLK_NODISCARD auto handle() const -> PipelineHandle;
+        SYLK_NODISCARD auto object_count() const -> u32;  // live objects, not the ones culled
+        SYLK_NODISCARD auto pending_uploads() const -> u32;
+        SYLK_NODISCARD auto empty() const -> bool;
+        SYLK_NODISCARD auto valid() const -> bool;
+
+      private:
+        void create_descriptors(const PipelineLayoutCache::Layout& draw_layout, DescriptorAllocator& descriptor_allocator);
+        void mark_dirty(u32 id);
+        void upload(vk::CommandBuffer cmd);
+
+      private:
+        const vk::Device& device_;
+        DescriptorBuffer* descriptor_buffer_ = nullptr;
+        u32               capacity_          = 0;
+
+        Shader                       vertex_shader_;
+        PipelineDesc                 desc_;
+        PipelineHandle               handle_;
+        ComputePipeline              cull_pipeline_;
+        PushConstants<CullConstants> cull_constants_;
+        DescriptorTemplate           draw_template_;
+
+        Buffer          object_buffer_;
+        Buffer          command_buffer_;
+        Buffer          count_buffer_;
+        StreamingBuffer upload_stream_;
+        bool            cleared_ = false;
+
+        // one of each, depending on the descriptor backend
+        vk::DescriptorSet            draw_set_;
+        vk::DescriptorSet            cull_set_;
+        DescriptorBuffer::Allocation draw_descriptors_;
+        DescriptorBuffer::Allocation cull_descriptors_;
+
+        // the cpu copy of every slot, the gpu one only ever gets written from here
+        std::vector<GpuObject>      objects_;
+        std::vector<u32>            free_;
+        std::vector<u32>            dirty_;
+        std::vector<bool>           dirty_flags_;
+        std::vector<vk::BufferCopy> copies_;
+        glm::mat4                   view_projection_ {1.0f};
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_RENDER_GPUSCENE_HPP
@@ -0,0 +1,29 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_RENDER_SPRITE_HPP
+#define SYLK_VULKAN_RENDER_SPRITE_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/render/texture_atlas.hpp>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+namespace sylk {
+
+    // a textured quad in window pixels, the origin is the top left corner and y points down
+    // sprites are drawn after every other draw of the frame, lower layers first, see SpriteBatch
+    struct Sprite {
+        glm::vec2   position {0.0f};  // of the centre
+        glm::vec2   size {1.0f};
+        f32         rotation = 0.0f;  // radians, clockwise on screen
+        glm::vec4   color {1.0f};     // multiplies the texel
+        AtlasRegion region {};
+        i16         layer = 0;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_RENDER_SPRITE_HPP
@@ -0,0 +1,104 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_RENDER_SPRITEBATCH_HPP
+#define SYLK_VULKAN_RENDER_SPRITEBATCH_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/command/command_encoder.hpp>
+#include <sylk/vulkan/descriptor/bindless_table.hpp>
+#include <sylk/vulkan/memory/streaming_buffer.hpp>
+#include <sylk/vulkan/pipeline/pipeline_desc.hpp>
+#include <sylk/vulkan/pipeline/pipeline_layout_cache.hpp>
+#include <sylk/vulkan/pipeline/push_constants.hpp>
+#include <sylk/vulkan/render/sprite.hpp>
+#include <sylk/vulkan/shader/draw_constants.hpp>
+#include <sylk/vulkan/shader/shader.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace sylk {
+
+    // draws every sprite of a frame in as few draw calls as there are runs of sprites sharing an image
+    // sprites are sorted by layer and then by image, so the order of a frame is only kept between sprites that share
+    // both, each run of equal images is one instanced draw of sprite.vert, which builds the quad from gl_VertexIndex
+    // instances are written in sorted order straight into a persistently mapped StreamingBuffer, nothing is copied
+    // twice and nothing waits on the gpu
+    //
+    // textures are read through the BindlessTable, so a SpriteBatch only exists where the device supports it
+    class SpriteBatch {
+      public:
+        struct Stats {
+            u32 sprites = 0;
+            u32 batches = 0;
+        };
+
+      public:
+        SpriteBatch(const vk::Device& device, ShaderModuleCache& shader_modules);
+
+        // the sprite pipeline has to share the layout of base, so drawing sprites rebinds nothing but the pipeline
+        void create(vk::PhysicalDevice   physical_device,
+                    u32                  frame_count,
+                    BindlessTable&       bindless_table,
+                    PipelineLayoutCache& layouts,
+                    const PipelineDesc&  base);
+        void destroy();
+
+        // the owner requests desc() from the PipelineLibrary or the ShaderObjectCache and hands the handle back
+        void set_handle(PipelineHandle handle);
+
+        // same contract as GraphicsPipeline::reload_shader()
+        auto reload_shader(std::string_view source_name, std::span<const u32> code) -> std::pair<vk::ShaderModule, vk::ShaderModule>;
+
+        // takes the sprites of a frame and sorts them, sprites is left holding the storage of an earlier frame
+        // this only touches cpu memory, so it can run while the gpu is still busy with earlier frames
+        void build(std::vector<Sprite>& sprites);
+
+        // the caller must have waited on the fence guarding this slot
+        void begin_frame(u32 frame_slot);
+
+        // writes the instances of the last build() and records a draw per batch, the pipeline, the render state and
+        // the descriptor sets of the frame have to be bound already, extent is what the pixel coordinates span
+        void record(CommandEncoder& encoder, const PushConstants<DrawConstants>& draw_constants, vk::Extent2D extent);
+
+        SYLK_NODISCARD auto desc() const -> const PipelineDesc&;
+        SYLK_NODISCARD auto handle() const -> PipelineHandle;
+        SYLK_NODISCARD auto stats() const -> Stats;
+        SYLK_NODISCARD auto empty() const -> bool;
+        SYLK_NODISCARD auto valid() const -> bool;
+
+      private:
+        struct Batch {
+            u32 image;
+            u32 first;
+            u32 count;
+        };
+
+      private:
+        const vk::Device& device_;
+        BindlessTable*    bindless_table_ = nullptr;
+        vk::Sampler       sampler_;
+        u32               sampler_index_ = 0;
+
+        Shader         vertex_shader_;
+        Shader         fragment_shader_;
+        PipelineDesc   desc_;
+        PipelineHandle handle_;
+
+        StreamingBuffer instance_stream_;
+
+        // the layer, the image and the position in the frame packed into one key, so sorting is a sort of integers
+        std::vector<Sprite> sprites_;
+        std::vector<u64>    keys_;
+        std::vector<u64>    key_scratch_;
+        std::vector<Batch>  batches_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_RENDER_SPRITEBATCH_HPP
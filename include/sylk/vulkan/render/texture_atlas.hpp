@@ -0,0 +1,53 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_RENDER_TEXTUREATLAS_HPP
+#define SYLK_VULKAN_RENDER_TEXTUREATLAS_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <glm/vec4.hpp>
+
+#include <vector>
+
+namespace sylk {
+
+    // a part of an atlas page, image is the page's index in the BindlessTable
+    struct AtlasRegion {
+        u32       image = 0;
+        glm::vec4 uv_rect {0.0f, 0.0f, 1.0f, 1.0f};  // offset in xy, size in zw, in normalized texture coordinates
+    };
+
+    // maps region ids to the page and the part of it they cover, this is pure bookkeeping, the pages are textures that
+    // live and are added to the bindless table elsewhere
+    // packing many small images into few pages is what keeps a SpriteBatch at few batches, every page is a batch break
+    class TextureAtlas {
+      public:
+        // returns the id of the page, image is its bindless index
+        auto add_page(u32 image, vk::Extent2D extent) -> u32;
+
+        // the rect is in pixels of the page, returns the id of the region
+        auto add_region(u32 page, vk::Rect2D pixels) -> u32;
+        // cuts the page into equally sized cells, row by row, returns the id of the first, the rest follow in order
+        auto add_grid(u32 page, vk::Extent2D cell) -> u32;
+
+        SYLK_NODISCARD auto region(u32 id) const -> const AtlasRegion&;
+        SYLK_NODISCARD auto region_count() const -> u32;
+        SYLK_NODISCARD auto page_count() const -> u32;
+
+      private:
+        struct Page {
+            u32          image;
+            vk::Extent2D extent;
+        };
+
+      private:
+        std::vector<Page>        pages_;
+        std::vector<AtlasRegion> regions_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_RENDER_TEXTUREATLAS_HPP
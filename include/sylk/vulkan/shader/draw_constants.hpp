@@ -0,0 +1,22 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_SHADER_DRAWCONSTANTS_HPP
+#define SYLK_VULKAN_SHADER_DRAWCONSTANTS_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+
+#include <glm/mat4x4.hpp>
+
+namespace sylk {
+
+    // the per draw data of shader.vert, pushed right before every draw instead of going through a buffer
+    struct DrawConstants {
+        glm::mat4 model {1.0f};
+        u32       material_index = 0;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_SHADER_DRAWCONSTANTS_HPP
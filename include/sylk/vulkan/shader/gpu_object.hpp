@@ -0,0 +1,36 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_SHADER_GPUOBJECT_HPP
+#define SYLK_VULKAN_SHADER_GPUOBJECT_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include <array>
+
+namespace sylk {
+    // an element of the object buffer of scene.vert and cull.comp, std430, storage buffers aren't reflected, so this
+    // has to be kept in sync with the Object struct of both by hand
+    struct GpuObject {
+        glm::mat4 model {1.0f};
+        glm::vec4 bounds {0.0f, 0.0f, 0.0f, 1.0f};  // bounding sphere in model space, centre in xyz, radius in w
+        u32       index_count    = 0;               // zero never draws, free slots are left like that
+        u32       first_index    = 0;
+        i32       vertex_offset  = 0;
+        u32       material_index = 0;
+    };
+
+    // the push constants of cull.comp, the planes of the frustum the objects are culled against
+    struct CullConstants {
+        std::array<glm::vec4, 6> planes;  // pointing inwards, xyz is the normal and w the distance
+        u32                      object_count;
+    };
+
+    static_assert(sizeof(GpuObject) == 96, "GpuObject no longer matches the std430 layout of Object");
+}
+
+#endif  // SYLK_VULKAN_SHADER_GPUOBJECT_HPP
@@ -0,0 +1,20 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_SHADER_INSTANCEDATA_HPP
+#define SYLK_VULKAN_SHADER_INSTANCEDATA_HPP
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+namespace sylk {
+    // the per instance inputs of instanced.vert, reflected like Vertex, this only has to match them in size and order
+    struct InstanceData {
+        glm::mat4 transform {1.0f};
+        glm::vec4 color {1.0f};
+        glm::vec4 uv_rect {0.0f, 0.0f, 1.0f, 1.0f};  // offset in xy, size in zw
+    };
+}
+
+#endif  // SYLK_VULKAN_SHADER_INSTANCEDATA_HPP
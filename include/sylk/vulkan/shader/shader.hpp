@@ -6,26 +6,31 @@
 #define SYLK_VULKAN_SHADER_SHADER_HPP
 
 #include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/shader/shader_module_cache.hpp>
 #include <sylk/vulkan/vulkan.hpp>
 
+#include <span>
 #include <vector>
 
 namespace sylk {
+    // spir-v is embedded into the binary at build time, see <sylk/shaders/*.hpp>
+    // the module is shared with every other Shader created from the same code
     class Shader {
       public:
-        Shader(const vk::Device& device);
-        void create(const char* filename);
+        Shader(ShaderModuleCache& cache);
+        void create(std::span<const u32> code);
         void destroy();
 
-        auto get_module() const -> vk::ShaderModule;
+        // swaps the module for one built from new code and returns the one it replaced, null if the code didn't change
+        // pipelines that are still compiling may use the replaced module, so it's only released in destroy()
+        auto reload(std::span<const u32> code) -> vk::ShaderModule;
 
-      private:
-        void create_shader_module();
+        auto get_module() const -> vk::ShaderModule;
 
       private:
-        const vk::Device& device_;
-        std::vector<char> shader_code_;
-        vk::ShaderModule  shader_module_;
+        ShaderModuleCache&            cache_;
+        vk::ShaderModule              shader_module_;
+        std::vector<vk::ShaderModule> replaced_modules_;
     };
 }
 
@@ -0,0 +1,67 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_SHADER_SHADERHOTRELOAD_HPP
+#define SYLK_VULKAN_SHADER_SHADERHOTRELOAD_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sylk {
+
+    // development builds only, see SYLK_SHADER_HOT_RELOAD in CMakeLists.txt
+    // watches shaders/src and shaders/include with inotify and recompiles changed shaders with glslc on its own thread
+    // a change to an include recompiles every shader, since there's no telling which of them pull it in
+    // only the code is reloaded, changes to a shader's interface still need a rebuild to update the reflection
+    class ShaderHotReload {
+      public:
+        struct Reload {
+            std::string          source_name;  // the file name in shaders/src, e.g. shader.frag
+            std::span<const u32> code;         // stays valid until destroy()
+        };
+
+      public:
+        ShaderHotReload() = default;
+        ShaderHotReload(const ShaderHotReload&)                    = delete;
+        auto operator=(const ShaderHotReload&) -> ShaderHotReload& = delete;
+
+        void create();
+        void destroy();
+
+        // every shader that finished compiling since the last call, meant to be called between frames
+        auto poll() -> std::vector<Reload>;
+
+      private:
+        struct Compiled {
+            std::string      source_name;
+            std::vector<u32> code;
+        };
+
+        void watch(const std::stop_token& stop_token);
+        auto compile(const std::filesystem::path& source) -> bool;
+
+      private:
+        i32 inotify_fd_    = -1;
+        i32 source_watch_  = -1;
+        i32 include_watch_ = -1;
+
+        std::mutex            mutex_;
+        std::vector<Compiled> compiled_;
+
+        // the shader module cache references code rather than copying it, so every blob handed out is kept around
+        std::deque<std::vector<u32>> code_;
+
+        std::jthread watcher_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_SHADER_SHADERHOTRELOAD_HPP
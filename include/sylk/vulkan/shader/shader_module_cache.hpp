@@ -0,0 +1,51 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_SHADER_SHADERMODULECACHE_HPP
+#define SYLK_VULKAN_SHADER_SHADERMODULECACHE_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <mutex>
+#include <span>
+#include <unordered_map>
+
+namespace sylk {
+
+    // hands out one shader module per distinct spir-v blob, keyed by a hash of its contents
+    // every acquire() has to be paired with a release(), the module is destroyed when the last user releases it
+    // a module may be released as soon as the pipelines using it have been created, drivers don't need it after that
+    // the code is referenced rather than copied, which is fine for the spir-v embedded at build time
+    class ShaderModuleCache {
+      public:
+        explicit ShaderModuleCache(const vk::Device& device);
+
+        void destroy();
+
+        auto acquire(std::span<const u32> code) -> vk::ShaderModule;
+        void release(vk::ShaderModule module);
+
+        // the spir-v a module was created from, shader objects are built from code rather than modules
+        SYLK_NODISCARD auto code(vk::ShaderModule module) const -> std::span<const u32>;
+        SYLK_NODISCARD auto module_count() const -> u64;
+
+      private:
+        struct Entry {
+            std::span<const u32> code;
+            vk::ShaderModule     module;
+            u32                  references = 0;
+        };
+
+      private:
+        const vk::Device& device_;
+
+        mutable std::mutex                      mutex_;
+        std::unordered_multimap<u64, Entry>     entries_;
+        std::unordered_map<VkShaderModule, u64>      keys_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_SHADER_SHADERMODULECACHE_HPP
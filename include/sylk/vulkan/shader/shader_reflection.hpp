@@ -0,0 +1,79 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_SHADER_SHADERREFLECTION_HPP
+#define SYLK_VULKAN_SHADER_SHADERREFLECTION_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace sylk {
+
+    // these are filled in at build time by tools/reflect, every shader in shaders/src gets a
+    // <sylk/shaders/<name>_<stage>_reflection.hpp> with a constexpr ShaderReflection named <NAME>_<STAGE>_REFLECTION
+
+    struct ReflectedBinding {
+        u32                  set;
+        u32                  binding;
+        vk::DescriptorType   type;
+        u32                  count;  // zero for runtime sized arrays
+        vk::ShaderStageFlags stages;
+    };
+
+    struct ReflectedPushConstants {
+        u32                  offset;
+        u32                  size;
+        vk::ShaderStageFlags stages;
+    };
+
+    // per vertex inputs are assumed to be interleaved in VERTEX_BINDING, in location order and without padding
+    // inputs named instance_* are interleaved the same way in INSTANCE_BINDING and advance once per instance
+    struct ReflectedVertexInput {
+        u32                 location;
+        vk::Format          format;
+        u32                 offset;
+        vk::VertexInputRate rate;
+    };
+
+    // the scalar type a constant is declared with in glsl, width aside
+    enum class ESpecConstantType : u8 {
+        BOOL,
+        INT,
+        UINT,
+        FLOAT,
+    };
+
+    struct ReflectedSpecConstant {
+        u32               id;
+        u32               size;
+        ESpecConstantType type;
+    };
+
+    struct ShaderReflection {
+        vk::ShaderStageFlagBits                 stage;
+        std::span<const ReflectedBinding>       bindings;
+        std::span<const ReflectedPushConstants> push_constants;
+        std::span<const ReflectedVertexInput>   vertex_inputs;
+        std::span<const ReflectedSpecConstant>  spec_constants;
+        u32                                     vertex_stride;
+        u32                                     instance_stride;  // zero without per instance inputs
+        std::array<u32, 3>                      local_size;       // zero for every stage but compute
+    };
+
+    inline constexpr u32 VERTEX_BINDING   = 0;
+    inline constexpr u32 INSTANCE_BINDING = 1;
+
+    // one description per binding the inputs use, the instance binding is left out if there are no per instance inputs
+    SYLK_NODISCARD auto vertex_binding_descriptions(const ShaderReflection& reflection)
+        -> std::vector<vk::VertexInputBindingDescription>;
+    SYLK_NODISCARD auto vertex_attribute_descriptions(const ShaderReflection& reflection)
+        -> std::vector<vk::VertexInputAttributeDescription>;
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_SHADER_SHADERREFLECTION_HPP
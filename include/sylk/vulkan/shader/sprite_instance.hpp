@@ -0,0 +1,25 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_SHADER_SPRITEINSTANCE_HPP
+#define SYLK_VULKAN_SHADER_SPRITEINSTANCE_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+namespace sylk {
+    // the per instance inputs of sprite.vert, reflected like Vertex, this only has to match them in size and order
+    // 40 bytes rather than the 64 of a matrix, at a hundred thousand sprites a frame the bus is what runs out first
+    struct SpriteInstance {
+        glm::vec2 position;
+        glm::vec2 size;
+        glm::vec4 uv_rect;
+        f32       rotation;
+        u32       color;  // rgba8, unpacked with unpackUnorm4x8
+    };
+}
+
+#endif  // SYLK_VULKAN_SHADER_SPRITEINSTANCE_HPP
@@ -9,8 +9,8 @@
 
 namespace sylk {
 
+    // per frame data only, anything per draw goes through DrawConstants
     struct UniformBufferObject {
-        glm::mat4 model;
         glm::mat4 view;
         glm::mat4 projection;
     };
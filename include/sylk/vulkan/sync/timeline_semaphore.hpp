@@ -0,0 +1,38 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_SYNC_TIMELINESEMAPHORE_HPP
+#define SYLK_VULKAN_SYNC_TIMELINESEMAPHORE_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+namespace sylk {
+
+    // monotonically increasing semaphore, each submission that signals it claims the next value
+    // waiting on a value waits on every submission that claimed a value at or below it
+    class TimelineSemaphore {
+      public:
+        explicit TimelineSemaphore(const vk::Device& device);
+
+        void create(u64 initial_value = 0);
+        void destroy();
+
+        auto claim_next_value() -> u64;
+        void wait(u64 value, u64 timeout = UINT64_MAX) const;
+
+        SYLK_NODISCARD auto is_reached(u64 value) const -> bool;
+        SYLK_NODISCARD auto completed_value() const -> u64;
+        SYLK_NODISCARD auto last_claimed_value() const -> u64;
+        SYLK_NODISCARD auto get_handle() const -> vk::Semaphore;
+
+      private:
+        const vk::Device& device_;
+        vk::Semaphore     semaphore_;
+        u64               last_claimed_value_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_SYNC_TIMELINESEMAPHORE_HPP
@@ -5,8 +5,36 @@
 #ifndef SYLK_VULKAN_UTILS_CONSTANTS_HPP
 #define SYLK_VULKAN_UTILS_CONSTANTS_HPP
 
+#include <sylk/core/utils/short_types.hpp>
+
 namespace sylk {
     inline constexpr const char* VK_LAYER_KHRONOS_NAME = "VK_LAYER_KHRONOS_validation";
+
+    // relative to the per user cache directory, so the cache doesn't depend on where the app was started from
+    inline constexpr const char* PIPELINE_CACHE_PATH                  = "sylk/pipelines.cache";
+    inline constexpr u32         PIPELINE_CACHE_SAVE_INTERVAL_SECONDS = 60;
+    inline constexpr u32         PIPELINE_COMPILE_WORKERS             = 2;
+
+    // the smallest maxPushConstantsSize the spec allows, anything above it has to be checked against the device
+    inline constexpr u32 GUARANTEED_PUSH_CONSTANTS_SIZE = 128;
+
+    // the persistent part has to fit the bindless table at its largest
+    inline constexpr u64 DESCRIPTOR_BUFFER_FRAME_SIZE      = 256 * 1024;
+    inline constexpr u64 DESCRIPTOR_BUFFER_PERSISTENT_SIZE = 8 * 1024 * 1024;
+
+    // per frame slot, a little over 170k instances of InstanceData
+    inline constexpr u64 INSTANCE_STREAM_FRAME_SIZE = 16 * 1024 * 1024;
+
+    // the most threads a per frame sort fans out to once it's large enough, see radix_sort()
+    inline constexpr u32 SORT_THREADS = 4;
+
+    // per frame slot, a little over 260k sprites of SpriteInstance
+    inline constexpr u64 SPRITE_STREAM_FRAME_SIZE = 10 * 1024 * 1024;
+
+    // 24 MiB of GpuObject and 5 MiB of indirect commands on the gpu, nothing of it is touched per frame on the cpu
+    inline constexpr u32 GPU_SCENE_CAPACITY = 256 * 1024;
+    // per frame slot, a little under 44k changed objects a frame, the rest waits for the frames after
+    inline constexpr u64 GPU_SCENE_UPLOAD_FRAME_SIZE = 4 * 1024 * 1024;
 }
 
 #endif  // SYLK_VULKAN_UTILS_CONSTANTS_HPP
@@ -0,0 +1,75 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifndef SYLK_VULKAN_UTILS_DEVICEFEATURES_HPP
+#define SYLK_VULKAN_UTILS_DEVICEFEATURES_HPP
+
+#include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/vulkan.hpp>
+
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace sylk {
+
+    // owns the feature structure chain that is handed to vkCreateDevice
+    // the chain links its own members together, so it can't be copied around
+    class DeviceFeatures {
+      public:
+        DeviceFeatures() = default;
+        DeviceFeatures(const DeviceFeatures&)                    = delete;
+        auto operator=(const DeviceFeatures&) -> DeviceFeatures& = delete;
+
+        void query(vk::PhysicalDevice device);
+
+        SYLK_NODISCARD auto supports_required() const -> bool;
+        SYLK_NODISCARD auto supports_pipeline_library() const -> bool;
+        SYLK_NODISCARD auto pipeline_library_fast_linking() const -> bool;
+        SYLK_NODISCARD auto supports_dynamic_blend() const -> bool;
+        SYLK_NODISCARD auto supports_bindless() const -> bool;
+        SYLK_NODISCARD auto supports_descriptor_buffer() const -> bool;
+        SYLK_NODISCARD auto supports_push_descriptor() const -> bool;
+        SYLK_NODISCARD auto supports_shader_object() const -> bool;
+        SYLK_NODISCARD auto supports_draw_indirect_count() const -> bool;
+        SYLK_NODISCARD auto has_extension(const char* name) const -> bool;
+        SYLK_NODISCARD auto enabled_extensions() const -> std::span<const char* const>;
+
+        auto chain() -> const vk::PhysicalDeviceFeatures2&;
+
+      private:
+        void query_pipeline_library(vk::PhysicalDevice device);
+        void query_extended_dynamic_state3(vk::PhysicalDevice device);
+        void query_descriptor_indexing(const vk::PhysicalDeviceVulkan12Features& supported);
+        void query_descriptor_buffer(vk::PhysicalDevice device, const vk::PhysicalDeviceVulkan12Features& supported);
+        void query_shader_object(vk::PhysicalDevice device, const vk::PhysicalDeviceVulkan13Features& supported);
+        void query_draw_indirect_count(const vk::PhysicalDeviceFeatures& supported, const vk::PhysicalDeviceVulkan12Features& supported_vk12);
+
+      private:
+        vk::PhysicalDeviceFeatures2        features_;
+        vk::PhysicalDeviceVulkan12Features vk12_features_;
+        vk::PhysicalDeviceVulkan13Features vk13_features_;
+
+        vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT pipeline_library_features_;
+        vk::PhysicalDeviceExtendedDynamicState3FeaturesEXT   dynamic_state3_features_;
+        vk::PhysicalDeviceDescriptorBufferFeaturesEXT        descriptor_buffer_features_;
+        vk::PhysicalDeviceShaderObjectFeaturesEXT            shader_object_features_;
+
+        bool                     supports_required_             = false;
+        bool                     supports_pipeline_library_     = false;
+        bool                     pipeline_library_fast_linking_ = false;
+        bool                     supports_dynamic_blend_        = false;
+        bool                     supports_bindless_             = false;
+        bool                     supports_descriptor_buffer_    = false;
+        bool                     supports_push_descriptor_      = false;
+        bool                     supports_shader_object_        = false;
+        bool                     supports_draw_indirect_count_  = false;
+        std::set<std::string>    available_extensions_;
+        std::vector<const char*> enabled_extensions_;
+    };
+
+}  // namespace sylk
+
+#endif  // SYLK_VULKAN_UTILS_DEVICEFEATURES_HPP
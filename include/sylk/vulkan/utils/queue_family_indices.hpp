@@ -15,8 +15,13 @@ namespace sylk {
     struct QueueFamilyIndices {
         std::optional<u32> graphics;
         std::optional<u32> presentation;
+        std::optional<u32> compute;  // only set for families that can't do graphics work
 
         SYLK_NODISCARD auto has_required() const -> bool { return graphics.has_value() && presentation.has_value(); }
+        SYLK_NODISCARD auto has_async_compute() const -> bool { return compute.has_value(); }
+
+        // devices without a dedicated compute family still get a compute queue, it just won't overlap graphics
+        SYLK_NODISCARD auto compute_family() const -> u32 { return compute.value_or(graphics.value()); }
 
         static auto find(vk::PhysicalDevice device, vk::SurfaceKHR surface) -> QueueFamilyIndices;
     };
@@ -9,6 +9,9 @@
 #define VULKAN_HPP_NO_CONSTRUCTORS
 #define VULKAN_HPP_NO_EXCEPTIONS
 #define VULKAN_HPP_ASSERT_ON_RESULT
+
+// extension commands aren't exported by the loader, so everything goes through a dispatcher that's filled in at runtime
+#define VULKAN_HPP_DISPATCH_LOADER_DYNAMIC 1
 #include <vulkan/vulkan.hpp>
 
 #endif  // SYLK_VULKAN_HPP
@@ -5,34 +5,83 @@
 #ifndef SYLK_VULKAN_WINDOW_GRAPHICSPIPELINE_HPP
 #define SYLK_VULKAN_WINDOW_GRAPHICSPIPELINE_HPP
 
+#include <sylk/shaders/instanced_vert_reflection.hpp>
+#include <sylk/shaders/shader_frag_reflection.hpp>
+#include <sylk/shaders/shader_vert_reflection.hpp>
+#include <sylk/vulkan/pipeline/pipeline_desc.hpp>
+#include <sylk/vulkan/pipeline/pipeline_layout_cache.hpp>
+#include <sylk/vulkan/pipeline/pipeline_library.hpp>
+#include <sylk/vulkan/pipeline/push_constants.hpp>
+#include <sylk/vulkan/pipeline/shader_object_cache.hpp>
+#include <sylk/vulkan/pipeline/specialization.hpp>
+#include <sylk/vulkan/shader/draw_constants.hpp>
 #include <sylk/vulkan/shader/shader.hpp>
 #include <sylk/vulkan/vulkan.hpp>
 
+#include <span>
+#include <string_view>
+#include <utility>
+
 namespace sylk {
 
+    // the default pipeline everything falls back to while variants are still compiling
+    // variants are described by copying base_desc() and changing whatever needs to differ
+    // instanced draws have a default of their own, instanced.vert with the per instance stream in INSTANCE_BINDING, it
+    // shares the layout of the default pipeline, but nothing falls back to it since no other pipeline reads instances
     class GraphicsPipeline {
       public:
-        GraphicsPipeline(const vk::Device& device);
-        void create(vk::Extent2D extent, vk::RenderPass renderpass);
-        void destroy() const;
-        void destroy_descriptorset_layouts();
+        GraphicsPipeline(const vk::Device& device, ShaderModuleCache& shader_modules);
+        void create(vk::RenderPass renderpass, PipelineLibrary& library, PipelineLayoutCache& layouts);
+        // same description, but the default handle refers to shader objects and there is no pipeline at all
+        void create(ShaderObjectCache& shader_objects, PipelineLayoutCache& layouts);
+        void destroy();
+
+        // matched against the file names in shaders/src, returns the replaced module and its replacement, or two nulls
+        // if the shader isn't one of ours or didn't change, the descriptions handed out before still use the old module
+        auto reload_shader(std::string_view source_name, std::span<const u32> code) -> std::pair<vk::ShaderModule, vk::ShaderModule>;
 
         auto get_layout() const -> vk::PipelineLayout;
-        auto get_handle() const -> vk::Pipeline;
         auto get_descriptor_set_layout() const -> vk::DescriptorSetLayout;
+        auto cached_layout() const -> const PipelineLayoutCache::Layout&;
+        auto draw_constants() const -> const PushConstants<DrawConstants>&;
+        auto default_handle() const -> PipelineHandle;
+        auto base_desc() const -> const PipelineDesc&;
+        auto instanced_handle() const -> PipelineHandle;
+        auto instanced_desc() const -> const PipelineDesc&;
+
+        // base_desc() with the constants of one stage replaced, the library caches every distinct set separately
+        template<typename... Constants>
+        auto vertex_variant(const SpecializationSet<SHADER_VERT_REFLECTION, Constants...>& constants) const -> PipelineDesc {
+            auto desc                  = base_desc_;
+            desc.vertex_specialization = constants.data();
+            return desc;
+        }
+
+        template<typename... Constants>
+        auto fragment_variant(const SpecializationSet<SHADER_FRAG_REFLECTION, Constants...>& constants) const -> PipelineDesc {
+            auto desc                    = base_desc_;
+            desc.fragment_specialization = constants.data();
+            return desc;
+        }
 
       private:
-        void create_descriptorset_layout();
+        void describe(vk::RenderPass renderpass, PipelineLayoutCache& layouts);
 
       private:
-        const vk::Device&       device_;
-        vk::DescriptorSetLayout descriptor_set_layout_;
-        vk::PipelineLayout      layout_;
-        vk::Pipeline            pipeline_;
-        Shader                  vertex_shader_;
-        Shader                  fragment_shader_;
+        const vk::Device&                  device_;
+        vk::DescriptorSetLayout            descriptor_set_layout_;
+        vk::PipelineLayout                 layout_;
+        const PipelineLayoutCache::Layout* cached_layout_ = nullptr;
+        PushConstants<DrawConstants>       draw_constants_;
+        PipelineHandle                     default_handle_;
+        PipelineDesc                       base_desc_;
+        PipelineHandle                     instanced_handle_;
+        PipelineDesc                       instanced_desc_;
+        Shader                             vertex_shader_;
+        Shader                             instanced_vertex_shader_;
+        Shader                             fragment_shader_;
     };
 
 }
 
-#endif  // SYLK_VULKAN_WINDOW_GRAPHICSPIPELINE_HPP
\ No newline at end of file
+#endif  // SYLK_VULKAN_WINDOW_GRAPHICSPIPELINE_HPP
@@ -7,11 +7,36 @@
 
 #include <sylk/core/utils/short_types.hpp>
 
+#include <sylk/vulkan/command/command_allocator.hpp>
+#include <sylk/vulkan/command/command_encoder.hpp>
+#include <sylk/vulkan/command/queue.hpp>
+#include <sylk/vulkan/command/submit_batcher.hpp>
+#include <sylk/vulkan/descriptor/bindless_table.hpp>
+#include <sylk/vulkan/descriptor/descriptor_allocator.hpp>
+#include <sylk/vulkan/descriptor/descriptor_buffer.hpp>
+#include <sylk/vulkan/descriptor/descriptor_template.hpp>
 #include <sylk/vulkan/memory/buffer.hpp>
+#include <sylk/vulkan/memory/streaming_buffer.hpp>
+#include <sylk/vulkan/memory/texture.hpp>
+#include <sylk/vulkan/pipeline/pipeline_cache.hpp>
+#include <sylk/vulkan/pipeline/pipeline_layout_cache.hpp>
+#include <sylk/vulkan/pipeline/pipeline_library.hpp>
+#include <sylk/vulkan/pipeline/shader_object_cache.hpp>
+#include <sylk/vulkan/render/frame_packet.hpp>
+#include <sylk/vulkan/render/gpu_scene.hpp>
+#include <sylk/vulkan/render/sprite_batch.hpp>
+#include <sylk/vulkan/render/texture_atlas.hpp>
+#include <sylk/vulkan/shader/shader_hot_reload.hpp>
+#include <sylk/vulkan/shader/shader_module_cache.hpp>
 #include <sylk/vulkan/shader/vertex.hpp>
+#include <sylk/vulkan/utils/device_features.hpp>
+#include <sylk/vulkan/utils/queue_family_indices.hpp>
 #include <sylk/vulkan/vulkan.hpp>
 #include <sylk/vulkan/window/graphics_pipeline.hpp>
 
+#include <chrono>
+#include <functional>
+#include <unordered_map>
 #include <vector>
 
 struct GLFWwindow;
@@ -26,62 +51,134 @@ namespace sylk {
             std::vector<vk::PresentModeKHR>   present_modes;
         };
 
+        using SimulateCallback = std::function<void(FramePacket&)>;
+
       public:
         explicit Swapchain(const vk::Device& device);
 
         void create(vk::PhysicalDevice physical_device, GLFWwindow* window, vk::SurfaceKHR surface);
         void recreate();
         void destroy();
+
+        // a frame is split into stages so the cpu can work on the next frame while the gpu is still drawing
+        // only record_and_submit() ever waits on the gpu, and only on the frame slot it's about to reuse
+        void simulate(const SimulateCallback& callback);
+        void build_draw_list();
+        void record_and_submit();
         void draw_next();
 
         SYLK_NODISCARD auto query_device_support_details(vk::PhysicalDevice device, vk::SurfaceKHR surface) const -> SupportDetails;
-        void                set_queues(vk::Queue graphics, vk::Queue present);
+        void                set_queues(const QueueFamilyIndices& indices);
+        void                set_device_features(const DeviceFeatures& features);
+        // only takes effect where VK_EXT_shader_object is supported, has to be set before create()
+        void                set_prefer_shader_objects(bool prefer);
+        // replaces the default scene of draw_next() with this many moving sprites, zero keeps the default scene
+        void                set_sprite_benchmark(u32 sprite_count);
+        // fills the gpu scene with this many static objects and pans across them, has to be set before create()
+        void                set_gpu_scene_benchmark(u32 object_count);
+
+        auto graphics_queue() -> Queue&;
+        // the graphics queue itself unless the device has a dedicated compute family
+        auto compute_queue() -> Queue&;
+
+        // anything added before record_and_submit() goes out in the same vkQueueSubmit2 as the frame itself
+        auto submit_batcher() -> SubmitBatcher&;
+        // only one of these is in use, descriptor buffers whenever the device supports them
+        auto descriptor_allocator() -> DescriptorAllocator&;
+        auto descriptor_buffer() -> DescriptorBuffer&;
+        // only valid() when the device supports descriptor indexing
+        auto bindless_table() -> BindlessTable&;
+        auto pipeline_cache() -> PipelineCache&;
+        auto pipeline_library() -> PipelineLibrary&;
+        // draws take their handles from here instead of the library while shader objects are in use
+        auto shader_objects() -> ShaderObjectCache&;
+        SYLK_NODISCARD auto uses_shader_objects() const -> bool;
+        auto shader_modules() -> ShaderModuleCache&;
+        auto default_pipeline() const -> const GraphicsPipeline&;
+        // the regions FramePacket::sprites can be drawn with, empty without a bindless table
+        auto sprite_atlas() const -> const TextureAtlas&;
+        // only valid() where the device supports indirect draw counts
+        auto gpu_scene() -> GpuScene&;
 
       private:
         void setup_swapchain();
         void destroy_partial();
         void create_image_views();
         void create_renderpass();
-        void create_command_pool();
-        void create_command_buffer();
+        void create_command_allocator();
         void create_framebuffers();
         void create_synchronizers();
         void create_uniform_buffers();
-        void create_descriptor_pool();
-        void update_uniform_buffers();
+        void create_instance_stream();
+        void create_descriptor_backend();
+        void create_bindless_table();
+        void create_sprite_batch();
+        void create_sprite_atlas(vk::CommandBuffer cmd_buffer);
+        void create_gpu_scene();
+        void simulate_default_scene(FramePacket& packet) const;
+        void simulate_sprite_benchmark(FramePacket& packet) const;
+        void simulate_gpu_scene_benchmark(FramePacket& packet) const;
         void create_descriptor_sets();
 
+        void upload_static_geometry();
+
+#ifdef SYLK_SHADER_HOT_RELOAD
+        // hands recompiled shaders to whatever uses them and swaps in the pipelines that finished rebuilding
+        void apply_shader_reloads();
+#endif
+
         template<typename T>
-        void create_staged_buffer(Buffer& buffer, vk::BufferUsageFlags buffer_type, const std::vector<T>& data);
+        void create_staged_buffer(Buffer& buffer, vk::BufferUsageFlags buffer_type, const std::vector<T>& data, vk::CommandBuffer cmd_buffer);
         void record_command_buffer(vk::CommandBuffer buffer, u32 image_index);
+        // asks the library once per handle and frame, it takes its mutex on every lookup
+        auto resolve_pipeline(PipelineHandle handle) -> vk::Pipeline;
+        void begin_rendering(vk::CommandBuffer buffer, u32 image_index) const;
+        void end_rendering(vk::CommandBuffer buffer, u32 image_index) const;
 
         auto select_surface_format(const std::vector<vk::SurfaceFormatKHR>& available_formats) const -> vk::SurfaceFormatKHR;
         auto select_present_mode(const std::vector<vk::PresentModeKHR>& available_modes) const -> vk::PresentModeKHR;
         auto select_extent_2d(vk::SurfaceCapabilitiesKHR capabilities, GLFWwindow* window) const -> vk::Extent2D;
 
       private:
-        u32              current_frame_;
-        u32              graphics_queue_family_index_;
-        GraphicsPipeline graphics_pipeline_;
+        u32                 current_frame_;
+        u32                 graphics_queue_family_index_;
+        PipelineCache       pipeline_cache_;
+        PipelineLibrary     pipeline_library_;
+        PipelineLayoutCache pipeline_layouts_;
+        ShaderModuleCache   shader_modules_;
+        ShaderObjectCache   shader_objects_;
+        GraphicsPipeline    graphics_pipeline_;
+        bool                prefer_shader_objects_ = false;
+        bool                use_shader_objects_    = false;
 
         GLFWwindow* window_;
 
-        const vk::Device&  device_;
-        vk::PhysicalDevice physical_device_;
-        vk::SurfaceKHR     surface_;
-        vk::SwapchainKHR   swapchain_;
-        vk::Format         format_;
-        vk::Extent2D       extent_;
-        vk::RenderPass     renderpass_;
-
-        vk::Queue graphics_queue_;
+        const vk::Device&     device_;
+        const DeviceFeatures* device_features_ = nullptr;
+        vk::PhysicalDevice    physical_device_;
+        vk::SurfaceKHR        surface_;
+        vk::SwapchainKHR      swapchain_;
+        vk::Format            format_;
+        vk::Extent2D          extent_;
+        vk::RenderPass        renderpass_;
+
+        Queue     graphics_queue_;
+        Queue     compute_queue_;
         vk::Queue presentation_queue_;
+        bool      compute_shares_graphics_ = false;
+
+        SubmitBatcher submit_batcher_;
 
-        vk::DescriptorPool descriptor_pool_;
-        std::vector<vk::DescriptorSet> descriptor_sets_;
+        DescriptorAllocator                       descriptor_allocator_;
+        DescriptorBuffer                          descriptor_buffer_;
+        BindlessTable                             bindless_table_;
+        std::vector<vk::DescriptorSet>            descriptor_sets_;
+        std::vector<DescriptorBuffer::Allocation> frame_descriptors_;
+        DescriptorTemplate                        frame_descriptor_template_;
+        bool                                      push_frame_descriptors_ = false;
 
-        vk::CommandPool                command_pool_;
-        std::vector<vk::CommandBuffer> command_buffers_;
+        CommandAllocator command_allocator_;
+        CommandEncoder   command_encoder_;
 
         std::vector<vk::Semaphore> semaphores_img_available_;
         std::vector<vk::Semaphore> semaphores_render_finished_;
@@ -103,6 +200,32 @@ namespace sylk {
         const std::vector<u16> indices_ = {0, 1, 2, 2, 3, 0};
 
         std::vector<Buffer> uniform_buffers_;
+        std::vector<Buffer> staging_buffers_;
+
+        // every instance of the frame goes in with a single copy, instanced draws index into it with firstInstance
+        StreamingBuffer instance_stream_;
+
+        SpriteBatch          sprite_batch_;
+        std::vector<Texture> sprite_pages_;
+        TextureAtlas         sprite_atlas_;
+        u32                  sprite_benchmark_ = 0;
+
+        GpuScene  gpu_scene_;
+        glm::mat4 scene_view_projection_ {1.0f};
+        u32       gpu_scene_benchmark_ = 0;
+
+#ifdef SYLK_SHADER_HOT_RELOAD
+        ShaderHotReload shader_hot_reload_;
+#endif
+
+        FramePacket                           frame_packet_;
+        std::vector<DrawCommand>              draw_list_;
+        std::vector<DrawPacket>               draw_packets_;  // the draw list in recording order
+        std::vector<DrawPacket>               draw_packet_scratch_;
+        std::unordered_map<u64, vk::Pipeline> resolved_pipelines_;  // cleared whenever a frame is recorded
+        std::vector<InstanceData>             instance_list_;
+        std::chrono::steady_clock::time_point start_time_;
+        std::chrono::steady_clock::time_point last_frame_time_;
     };
 
 }  // namespace sylk
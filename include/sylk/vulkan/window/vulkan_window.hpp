@@ -6,6 +6,7 @@
 #define SYLK_VULKAN_WINDOW_VULKANWINDOW_HPP
 
 #include <sylk/core/utils/short_types.hpp>
+#include <sylk/vulkan/utils/device_features.hpp>
 #include <sylk/vulkan/utils/validation_layers.hpp>
 #include <sylk/vulkan/vulkan.hpp>
 #include <sylk/vulkan/window/graphics_pipeline.hpp>
@@ -26,6 +27,15 @@ namespace sylk {
             i32         width      = 1280;
             i32         height     = 720;
             bool        fullscreen = false;
+
+            // draw with VK_EXT_shader_object instead of pipelines where the device supports it
+            bool shader_objects = false;
+
+            // draws this many moving sprites instead of the default scene, see Swapchain::set_sprite_benchmark()
+            u32 sprite_benchmark = 0;
+
+            // fills the gpu scene with this many objects instead, see Swapchain::set_gpu_scene_benchmark()
+            u32 gpu_scene_benchmark = 0;
         };
 
       public:
@@ -35,6 +45,11 @@ namespace sylk {
         void poll_events() const;
         void render();
 
+        // staged alternative to render(), see Swapchain for how the stages overlap with the gpu
+        void simulate(const Swapchain::SimulateCallback& callback);
+        void build_draw_list();
+        void record_and_submit();
+
         auto is_open() const -> bool;
 
       private:
@@ -54,6 +69,7 @@ namespace sylk {
 
         Settings         settings_;
         ValidationLayers validation_layers_;
+        DeviceFeatures   device_features_;
         Swapchain        swapchain_;
 
         std::vector<const char*>    required_extensions_;
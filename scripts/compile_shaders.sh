@@ -1,2 +0,0 @@
-glslc ../shaders/src/shader.vert -o ../shaders/vert.spv
-glslc ../shaders/src/shader.frag -o ../shaders/frag.spv
@@ -0,0 +1,15 @@
+// the global bindless table, see BindlessTable, the set and bindings have to match its constants
+// index with values from push constants, wrap them in nonuniformEXT() whenever they can differ within a draw
+
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout (set = 1, binding = 0) uniform texture2D bindless_images[];
+layout (set = 1, binding = 1) uniform sampler bindless_samplers[];
+
+layout (set = 1, binding = 2) readonly buffer BindlessBuffer {
+    uint words[];
+} bindless_buffers[];
+
+vec4 bindless_sample(uint image, uint sampler_index, vec2 uv) {
+    return texture(sampler2D(bindless_images[nonuniformEXT(image)], bindless_samplers[nonuniformEXT(sampler_index)]), uv);
+}
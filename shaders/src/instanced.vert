@@ -0,0 +1,30 @@
+#version 450
+
+layout (binding = 0) uniform UniformBufferObject {
+    mat4 view;
+    mat4 projection;
+} ubo;
+
+layout (push_constant) uniform DrawConstants {
+    mat4 model;
+    uint material_index;
+} draw;
+
+layout (location = 0) in vec2 in_pos;
+layout (location = 1) in vec3 in_color;
+
+// advanced once per instance, see InstanceData
+layout (location = 2) in mat4 instance_transform;
+layout (location = 6) in vec4 instance_color;
+layout (location = 7) in vec4 instance_uv_rect;
+
+layout (location = 0) out vec3 frag_color;
+layout (location = 1) out vec2 frag_uv;
+
+void main() {
+    gl_Position = draw.model * instance_transform * vec4(in_pos, 0.0, 1.0);
+    frag_color = in_color * instance_color.rgb;
+
+    // the quad spans [-0.5, 0.5], the rect is offset and size in normalized texture coordinates
+    frag_uv = instance_uv_rect.xy + (in_pos + 0.5) * instance_uv_rect.zw;
+}
\ No newline at end of file
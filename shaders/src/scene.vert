@@ -0,0 +1,39 @@
+#version 450
+
+layout (binding = 0) uniform UniformBufferObject {
+    mat4 view;
+    mat4 projection;
+} ubo;
+
+// model is the view projection of the whole scene, material_index is unused, every object carries its own
+layout (push_constant) uniform DrawConstants {
+    mat4 model;
+    uint material_index;
+} draw;
+
+// see GpuObject
+struct Object {
+    mat4 model;
+    vec4 bounds;
+    uint index_count;
+    uint first_index;
+    int vertex_offset;
+    uint material_index;
+};
+
+layout (set = 2, binding = 0) readonly buffer Objects {
+    Object objects[];
+};
+
+layout (location = 0) in vec2 in_pos;
+layout (location = 1) in vec3 in_color;
+
+layout (location = 0) out vec3 frag_color;
+
+void main() {
+    // cull.comp writes a single instance per draw, with the index of its object as the first instance
+    Object object = objects[gl_InstanceIndex];
+
+    gl_Position = draw.model * object.model * vec4(in_pos, 0.0, 1.0);
+    frag_color = in_color;
+}
\ No newline at end of file
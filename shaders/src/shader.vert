@@ -1,17 +1,21 @@
 #version 450
 
 layout (binding = 0) uniform UniformBufferObject {
-    mat4 model;
     mat4 view;
     mat4 projection;
 } ubo;
 
+layout (push_constant) uniform DrawConstants {
+    mat4 model;
+    uint material_index;
+} draw;
+
 layout (location = 0) in vec2 in_pos;
 layout (location = 1) in vec3 in_color;
 
 layout (location = 0) out vec3 frag_color;
 
 void main() {
-    gl_Position = ubo.model * vec4(in_pos, 0.0, 1.0);
+    gl_Position = draw.model * vec4(in_pos, 0.0, 1.0);
     frag_color = in_color;
 }
\ No newline at end of file
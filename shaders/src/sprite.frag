@@ -0,0 +1,16 @@
+#version 450
+
+#include "bindless.glsl"
+
+// the bindless index of the sampler every sprite is drawn with, set by SpriteBatch
+layout (constant_id = 0) const uint SAMPLER_INDEX = 0;
+
+layout (location = 0) in vec4 frag_color;
+layout (location = 1) in vec2 frag_uv;
+layout (location = 2) flat in uint frag_image;
+
+layout (location = 0) out vec4 out_color;
+
+void main() {
+    out_color = frag_color * bindless_sample(frag_image, SAMPLER_INDEX, frag_uv);
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#version 450
+
+layout (binding = 0) uniform UniformBufferObject {
+    mat4 view;
+    mat4 projection;
+} ubo;
+
+// model is the pixel to clip space projection of the batch, material_index the bindless image it samples
+layout (push_constant) uniform DrawConstants {
+    mat4 model;
+    uint material_index;
+} draw;
+
+// advanced once per instance, see SpriteInstance, there are no per vertex inputs at all
+layout (location = 0) in vec2 instance_position;
+layout (location = 1) in vec2 instance_size;
+layout (location = 2) in vec4 instance_uv_rect;
+layout (location = 3) in float instance_rotation;
+layout (location = 4) in uint instance_color;
+
+layout (location = 0) out vec4 frag_color;
+layout (location = 1) out vec2 frag_uv;
+layout (location = 2) flat out uint frag_image;
+
+// two triangles per sprite, drawn without vertex or index buffers
+const vec2 CORNERS[6] = vec2[](
+    vec2(-0.5, -0.5), vec2(0.5, -0.5), vec2(0.5, 0.5),
+    vec2(0.5, 0.5), vec2(-0.5, 0.5), vec2(-0.5, -0.5)
+);
+
+void main() {
+    vec2 corner = CORNERS[gl_VertexIndex];
+    vec2 local  = corner * instance_size;
+
+    float s = sin(instance_rotation);
+    float c = cos(instance_rotation);
+
+    gl_Position = draw.model * vec4(instance_position + vec2(local.x * c - local.y * s, local.x * s + local.y * c), 0.0, 1.0);
+    frag_color  = unpackUnorm4x8(instance_color);
+    frag_uv     = instance_uv_rect.xy + (corner + 0.5) * instance_uv_rect.zw;
+    frag_image  = draw.material_index;
+}
\ No newline at end of file
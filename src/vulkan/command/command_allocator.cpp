@@ -0,0 +1,95 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/command/command_allocator.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+#include <algorithm>
+
+namespace sylk {
+    CommandAllocator::CommandAllocator(const vk::Device& device)
+        : device_(device)
+        , thread_count_(0)
+        , current_slot_(0) {}
+
+    void CommandAllocator::create(const u32 queue_family_index, const u32 frame_count, const u32 thread_count) {
+        thread_count_ = thread_count;
+        pools_.resize(cast<u64>(frame_count) * thread_count);
+
+        const auto pool_info = vk::CommandPoolCreateInfo {
+            .flags            = vk::CommandPoolCreateFlagBits::eTransient,
+            .queueFamilyIndex = queue_family_index,
+        };
+
+        for (auto& pool : pools_) {
+            const auto [result, cmd_pool] = device_.createCommandPool(pool_info);
+            handle_result(result, "Failed to create command pool");
+            pool.pool = cmd_pool;
+        }
+
+        log(ELogLvl::TRACE, "Created {} command pools for {} frame(s) and {} thread(s)", pools_.size(), frame_count, thread_count);
+    }
+
+    void CommandAllocator::destroy() {
+        // destroying a pool frees its command buffers along with it
+        for (auto& pool : pools_) {
+            device_.destroyCommandPool(pool.pool);
+        }
+        pools_.clear();
+
+        log(ELogLvl::TRACE, "Destroyed command pools");
+    }
+
+    void CommandAllocator::begin_frame(const u32 frame_slot) {
+        current_slot_ = frame_slot;
+
+        for (u32 thread = 0; thread < thread_count_; ++thread) {
+            auto& pool = pools_[cast<u64>(current_slot_) * thread_count_ + thread];
+
+            // untouched pools have nothing to reset
+            if (pool.next_primary == 0 && pool.next_secondary == 0) {
+                continue;
+            }
+
+            handle_result(device_.resetCommandPool(pool.pool, {}), "Failed to reset command pool");
+            pool.next_primary   = 0;
+            pool.next_secondary = 0;
+        }
+    }
+
+    auto CommandAllocator::allocate(const u32 thread_index, const vk::CommandBufferLevel level) -> vk::CommandBuffer {
+        auto& pool = pools_[cast<u64>(current_slot_) * thread_count_ + thread_index];
+
+        const bool primary = level == vk::CommandBufferLevel::ePrimary;
+        auto&      buffers = (primary ? pool.primary : pool.secondary);
+        auto&      next    = (primary ? pool.next_primary : pool.next_secondary);
+
+        if (next == buffers.size()) {
+            grow(pool, level);
+        }
+
+        return buffers[next++];
+    }
+
+    auto CommandAllocator::thread_count() const -> u32 {
+        return thread_count_;
+    }
+
+    void CommandAllocator::grow(Pool& pool, const vk::CommandBufferLevel level) const {
+        auto& buffers = (level == vk::CommandBufferLevel::ePrimary ? pool.primary : pool.secondary);
+
+        // buffers stick around between frames, so growing geometrically settles quickly
+        const auto alloc_info = vk::CommandBufferAllocateInfo {
+            .commandPool        = pool.pool,
+            .level              = level,
+            .commandBufferCount = std::max<u32>(2, cast<u32>(buffers.size())),
+        };
+
+        const auto [result, allocated] = device_.allocateCommandBuffers(alloc_info);
+        // allocate() hands out the next buffer unconditionally, so there is no way to carry on without them
+        handle_result(result, "Failed to allocate command buffers", ELogLvl::CRITICAL);
+        buffers.insert(buffers.end(), allocated.begin(), allocated.end());
+    }
+}  // namespace sylk
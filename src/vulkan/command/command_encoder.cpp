@@ -0,0 +1,162 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/command/command_encoder.hpp>
+
+namespace {
+    // the slot of a bind point in the encoder's shadow state, other bind points are always recorded
+    auto bind_point_index(const vk::PipelineBindPoint bind_point) -> std::optional<sylk::u32> {
+        switch (bind_point) {
+        case vk::PipelineBindPoint::eGraphics:
+            return 0;
+        case vk::PipelineBindPoint::eCompute:
+            return 1;
+        default:
+            return std::nullopt;
+        }
+    }
+}  // namespace
+
+namespace sylk {
+    void CommandEncoder::begin(const vk::CommandBuffer cmd, const bool dynamic_blend) {
+        cmd_   = cmd;
+        stats_ = {};
+        dynamic_state_.begin(cmd, dynamic_blend);
+        invalidate();
+    }
+
+    void CommandEncoder::invalidate() {
+        pipelines_      = {};
+        program_        = nullptr;
+        vertex_buffers_ = {};
+        index_buffer_   = {};
+        sets_           = {};
+        viewport_.reset();
+        scissor_.reset();
+        dynamic_state_.invalidate();
+    }
+
+    void CommandEncoder::bind_pipeline(const vk::PipelineBindPoint bind_point, const vk::Pipeline pipeline) {
+        const auto index = bind_point_index(bind_point);
+        if (!issue_bind(index && pipelines_[*index] == pipeline)) {
+            return;
+        }
+
+        cmd_.bindPipeline(bind_point, pipeline);
+
+        if (index) {
+            pipelines_[*index] = pipeline;
+        }
+
+        if (bind_point == vk::PipelineBindPoint::eGraphics) {
+            program_ = nullptr;
+        }
+    }
+
+    void CommandEncoder::bind_program(const ShaderObjectCache::Program& program) {
+        if (!issue_bind(program_ == &program)) {
+            return;
+        }
+
+        program.bind(cmd_);
+        program_      = &program;
+        pipelines_[0] = nullptr;
+    }
+
+    void CommandEncoder::bind_vertex_buffer(const u32 binding, const vk::Buffer buffer, const vk::DeviceSize offset) {
+        const bool shadowed = binding < MAX_VERTEX_BINDINGS;
+        if (!issue_bind(shadowed && vertex_buffers_[binding].buffer == buffer && vertex_buffers_[binding].offset == offset)) {
+            return;
+        }
+
+        cmd_.bindVertexBuffers(binding, buffer, offset);
+
+        if (shadowed) {
+            vertex_buffers_[binding] = {.buffer = buffer, .offset = offset};
+        }
+    }
+
+    void CommandEncoder::bind_index_buffer(const vk::Buffer buffer, const vk::DeviceSize offset, const vk::IndexType type) {
+        if (!issue_bind(index_buffer_.buffer == buffer && index_buffer_.offset == offset && index_buffer_.type == type)) {
+            return;
+        }
+
+        cmd_.bindIndexBuffer(buffer, offset, type);
+        index_buffer_ = {.buffer = buffer, .offset = offset, .type = type};
+    }
+
+    void CommandEncoder::bind_descriptor_set(const vk::PipelineBindPoint bind_point,
+                                             const vk::PipelineLayout    layout,
+                                             const u32                   set,
+                                             const vk::DescriptorSet     descriptor_set) {
+        const auto index    = bind_point_index(bind_point);
+        const bool shadowed = index && set < MAX_SETS;
+        if (!issue_bind(shadowed && sets_[*index][set].layout == layout && sets_[*index][set].set == descriptor_set)) {
+            return;
+        }
+
+        cmd_.bindDescriptorSets(bind_point, layout, set, descriptor_set, {});
+
+        if (!shadowed) {
+            return;
+        }
+
+        // a set bound with another layout may have been disturbed, the same layout is the only one known to be compatible
+        auto& sets = sets_[*index];
+        for (auto& other : sets) {
+            if (other.layout != layout) {
+                other = {};
+            }
+        }
+
+        sets[set] = {.layout = layout, .set = descriptor_set};
+    }
+
+    void CommandEncoder::set_viewport(const vk::Viewport& viewport) {
+        if (!issue_state(viewport_ == viewport)) {
+            return;
+        }
+
+        cmd_.setViewport(0, viewport);
+        viewport_ = viewport;
+    }
+
+    void CommandEncoder::set_scissor(const vk::Rect2D& scissor) {
+        if (!issue_state(scissor_ == scissor)) {
+            return;
+        }
+
+        cmd_.setScissor(0, scissor);
+        scissor_ = scissor;
+    }
+
+    void CommandEncoder::set_render_state(const RenderState& state) {
+        dynamic_state_.apply(state);
+    }
+
+    auto CommandEncoder::cmd() const -> vk::CommandBuffer {
+        return cmd_;
+    }
+
+    auto CommandEncoder::stats() const -> Stats {
+        const auto dynamic_stats = dynamic_state_.stats();
+
+        auto stats = stats_;
+        stats.states_issued += dynamic_stats.recorded;
+        stats.states_skipped += dynamic_stats.skipped;
+
+        return stats;
+    }
+
+    auto CommandEncoder::issue_bind(const bool current) -> bool {
+        ++(current ? stats_.binds_skipped : stats_.binds_issued);
+        return !current;
+    }
+
+    auto CommandEncoder::issue_state(const bool current) -> bool {
+        ++(current ? stats_.states_skipped : stats_.states_issued);
+        return !current;
+    }
+}  // namespace sylk
@@ -0,0 +1,57 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/command/dynamic_state_tracker.hpp>
+
+namespace sylk {
+    void DynamicStateTracker::begin(const vk::CommandBuffer buffer, const bool dynamic_blend) {
+        buffer_        = buffer;
+        dynamic_blend_ = dynamic_blend;
+        valid_         = false;
+        stats_         = {};
+    }
+
+    void DynamicStateTracker::apply(const RenderState& state) {
+        set(current_.topology, state.topology, [this](const auto topology) { buffer_.setPrimitiveTopology(topology); });
+        set(current_.cull_mode, state.cull_mode, [this](const auto cull_mode) { buffer_.setCullMode(cull_mode); });
+        set(current_.front_face, state.front_face, [this](const auto front_face) { buffer_.setFrontFace(front_face); });
+        set(current_.depth_test, state.depth_test, [this](const auto depth_test) { buffer_.setDepthTestEnable(depth_test); });
+        set(current_.depth_write, state.depth_write, [this](const auto depth_write) { buffer_.setDepthWriteEnable(depth_write); });
+        set(current_.depth_compare, state.depth_compare, [this](const auto compare_op) { buffer_.setDepthCompareOp(compare_op); });
+
+        // without extended dynamic state 3 blending is part of the pipeline
+        if (dynamic_blend_) {
+            set(current_.blend, state.blend, [this](const auto blend) {
+                const vk::Bool32 enable   = blend_enabled(blend);
+                const auto       equation = blend_equation(blend);
+
+                buffer_.setColorBlendEnableEXT(0, enable);
+                buffer_.setColorBlendEquationEXT(0, equation);
+            });
+        }
+
+        valid_ = true;
+    }
+
+    void DynamicStateTracker::invalidate() {
+        valid_ = false;
+    }
+
+    auto DynamicStateTracker::stats() const -> Stats {
+        return stats_;
+    }
+
+    template<typename T, typename Record>
+    void DynamicStateTracker::set(T& current, const T& wanted, Record&& record) {
+        if (valid_ && current == wanted) {
+            ++stats_.skipped;
+            return;
+        }
+
+        record(wanted);
+        current = wanted;
+        ++stats_.recorded;
+    }
+}  // namespace sylk
@@ -0,0 +1,205 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/command/queue.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+#include <vector>
+
+namespace sylk {
+    Queue::Queue(const vk::Device& device)
+        : family_index_(0)
+        , timeline_(device) {}
+
+    void Queue::create(const vk::Queue queue, const u32 family_index) {
+        queue_        = queue;
+        family_index_ = family_index;
+        timeline_.create();
+    }
+
+    void Queue::destroy() {
+        timeline_.destroy();
+    }
+
+    auto Queue::submit(const SubmitData data) -> u64 {
+        return submit_batch({&data, 1}, data.fence);
+    }
+
+    auto Queue::submit_batch(const std::span<const SubmitData> submits, const vk::Fence fence) -> u64 {
+        if (submits.empty()) {
+            return timeline_.last_claimed_value();
+        }
+
+        const auto to_submit_info = [](const SemaphoreDependency& dependency) {
+            return vk::SemaphoreSubmitInfo {
+                .semaphore = dependency.semaphore,
+                .value     = dependency.value,
+                .stageMask = dependency.stages,
+            };
+        };
+
+        // every submit info points into these, so they must be sized up front to never reallocate
+        size_t wait_count = 0, cmd_buffer_count = 0, signal_count = 1;
+        for (const auto& submit : submits) {
+            wait_count += submit.waits.size();
+            cmd_buffer_count += submit.command_buffers.size();
+            signal_count += submit.signals.size();
+        }
+
+        std::vector<vk::SemaphoreSubmitInfo>     wait_infos;
+        std::vector<vk::CommandBufferSubmitInfo> cmd_buffer_infos;
+        std::vector<vk::SemaphoreSubmitInfo>     signal_infos;
+        std::vector<vk::SubmitInfo2>             submit_infos;
+        wait_infos.reserve(wait_count);
+        cmd_buffer_infos.reserve(cmd_buffer_count);
+        signal_infos.reserve(signal_count);
+        submit_infos.reserve(submits.size());
+
+        const u64 timeline_value = timeline_.claim_next_value();
+
+        for (size_t i = 0; i < submits.size(); ++i) {
+            const auto& submit = submits[i];
+
+            const auto wait_offset = wait_infos.size();
+            for (const auto& wait : submit.waits) {
+                wait_infos.push_back(to_submit_info(wait));
+            }
+
+            const auto cmd_buffer_offset = cmd_buffer_infos.size();
+            for (const auto cmd_buffer : submit.command_buffers) {
+                cmd_buffer_infos.push_back(vk::CommandBufferSubmitInfo {.commandBuffer = cmd_buffer});
+            }
+
+            const auto signal_offset = signal_infos.size();
+            for (const auto& signal : submit.signals) {
+                signal_infos.push_back(to_submit_info(signal));
+            }
+
+            // submissions complete in order, so signalling the timeline on the last one covers the whole batch
+            if (i == submits.size() - 1) {
+                signal_infos.push_back(to_submit_info({.semaphore = timeline_.get_handle(), .value = timeline_value}));
+            }
+
+            submit_infos.push_back(vk::SubmitInfo2 {
+                .waitSemaphoreInfoCount   = cast<u32>(wait_infos.size() - wait_offset),
+                .pWaitSemaphoreInfos      = wait_infos.data() + wait_offset,
+                .commandBufferInfoCount   = cast<u32>(cmd_buffer_infos.size() - cmd_buffer_offset),
+                .pCommandBufferInfos      = cmd_buffer_infos.data() + cmd_buffer_offset,
+                .signalSemaphoreInfoCount = cast<u32>(signal_infos.size() - signal_offset),
+                .pSignalSemaphoreInfos    = signal_infos.data() + signal_offset,
+            });
+        }
+
+        // the timeline value is already claimed, carrying on would leave anyone waiting on it hanging forever
+        handle_result(queue_.submit2(submit_infos, fence), "Failed to submit to queue", ELogLvl::CRITICAL);
+
+        return timeline_value;
+    }
+
+    void Queue::wait_idle() const {
+        handle_result(queue_.waitIdle(), "Device error");
+    }
+
+    auto Queue::wait_point(const u64 value, const vk::PipelineStageFlags2 stages) const -> SemaphoreDependency {
+        return {
+            .semaphore = timeline_.get_handle(),
+            .value     = value,
+            .stages    = stages,
+        };
+    }
+
+    auto Queue::get_timeline() const -> const TimelineSemaphore& {
+        return timeline_;
+    }
+
+    auto Queue::get_handle() const -> vk::Queue {
+        return queue_;
+    }
+
+    auto Queue::family_index() const -> u32 {
+        return family_index_;
+    }
+
+    void Queue::release(const vk::CommandBuffer buffer, const BufferTransfer& transfer) {
+        // within a single family the acquiring side records a plain barrier instead
+        if (transfer.src_family == transfer.dst_family) {
+            return;
+        }
+
+        const auto barrier = vk::BufferMemoryBarrier2 {
+            .srcStageMask        = transfer.src_stages,
+            .srcAccessMask       = transfer.src_access,
+            .dstStageMask        = vk::PipelineStageFlagBits2::eNone,
+            .dstAccessMask       = vk::AccessFlagBits2::eNone,
+            .srcQueueFamilyIndex = transfer.src_family,
+            .dstQueueFamilyIndex = transfer.dst_family,
+            .buffer              = transfer.buffer,
+            .offset              = transfer.offset,
+            .size                = transfer.size,
+        };
+
+        buffer.pipelineBarrier2(vk::DependencyInfo().setBufferMemoryBarriers(barrier));
+    }
+
+    void Queue::acquire(const vk::CommandBuffer buffer, const BufferTransfer& transfer) {
+        const bool same_family = transfer.src_family == transfer.dst_family;
+
+        // on a family transfer, the release half already made the source writes available
+        const auto barrier = vk::BufferMemoryBarrier2 {
+            .srcStageMask        = (same_family ? transfer.src_stages : vk::PipelineStageFlagBits2::eNone),
+            .srcAccessMask       = (same_family ? transfer.src_access : vk::AccessFlagBits2::eNone),
+            .dstStageMask        = transfer.dst_stages,
+            .dstAccessMask       = transfer.dst_access,
+            .srcQueueFamilyIndex = (same_family ? VK_QUEUE_FAMILY_IGNORED : transfer.src_family),
+            .dstQueueFamilyIndex = (same_family ? VK_QUEUE_FAMILY_IGNORED : transfer.dst_family),
+            .buffer              = transfer.buffer,
+            .offset              = transfer.offset,
+            .size                = transfer.size,
+        };
+
+        buffer.pipelineBarrier2(vk::DependencyInfo().setBufferMemoryBarriers(barrier));
+    }
+
+    void Queue::release(const vk::CommandBuffer buffer, const ImageTransfer& transfer) {
+        if (transfer.src_family == transfer.dst_family) {
+            return;
+        }
+
+        // the layout transition is executed once, between the release and acquire, so both halves specify it
+        const auto barrier = vk::ImageMemoryBarrier2 {
+            .srcStageMask        = transfer.src_stages,
+            .srcAccessMask       = transfer.src_access,
+            .dstStageMask        = vk::PipelineStageFlagBits2::eNone,
+            .dstAccessMask       = vk::AccessFlagBits2::eNone,
+            .oldLayout           = transfer.old_layout,
+            .newLayout           = transfer.new_layout,
+            .srcQueueFamilyIndex = transfer.src_family,
+            .dstQueueFamilyIndex = transfer.dst_family,
+            .image               = transfer.image,
+            .subresourceRange    = transfer.range,
+        };
+
+        buffer.pipelineBarrier2(vk::DependencyInfo().setImageMemoryBarriers(barrier));
+    }
+
+    void Queue::acquire(const vk::CommandBuffer buffer, const ImageTransfer& transfer) {
+        const bool same_family = transfer.src_family == transfer.dst_family;
+
+        const auto barrier = vk::ImageMemoryBarrier2 {
+            .srcStageMask        = (same_family ? transfer.src_stages : vk::PipelineStageFlagBits2::eNone),
+            .srcAccessMask       = (same_family ? transfer.src_access : vk::AccessFlagBits2::eNone),
+            .dstStageMask        = transfer.dst_stages,
+            .dstAccessMask       = transfer.dst_access,
+            .oldLayout           = transfer.old_layout,
+            .newLayout           = transfer.new_layout,
+            .srcQueueFamilyIndex = (same_family ? VK_QUEUE_FAMILY_IGNORED : transfer.src_family),
+            .dstQueueFamilyIndex = (same_family ? VK_QUEUE_FAMILY_IGNORED : transfer.dst_family),
+            .image               = transfer.image,
+            .subresourceRange    = transfer.range,
+        };
+
+        buffer.pipelineBarrier2(vk::DependencyInfo().setImageMemoryBarriers(barrier));
+    }
+}  // namespace sylk
@@ -0,0 +1,133 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/command/submit_batcher.hpp>
+
+#include <algorithm>
+
+namespace sylk {
+    void SubmitBatcher::add(Queue& queue, const Queue::SubmitData data) {
+        entries_.push_back(Entry {
+            .queue = &queue,
+            .group =
+                Group {
+                    .command_buffers = {data.command_buffers.begin(), data.command_buffers.end()},
+                    .waits           = {data.waits.begin(), data.waits.end()},
+                    .signals         = {data.signals.begin(), data.signals.end()},
+                },
+            .fence = data.fence,
+        });
+    }
+
+    void SubmitBatcher::flush() {
+        calls_.clear();
+
+        for (const auto& entry : entries_) {
+            // binary semaphores must have their signal submitted before anything waits on them
+            for (const auto& wait : entry.group.waits) {
+                for (auto& other : calls_) {
+                    if (other.open && other.queue != entry.queue && signals_semaphore(other, wait.semaphore)) {
+                        submit(other);
+                    }
+                }
+            }
+
+            auto call = std::find_if(calls_.begin(), calls_.end(), [&](const Call& c) { return c.open && c.queue == entry.queue; });
+            if (call == calls_.end()) {
+                calls_.push_back(Call {.queue = entry.queue});
+                call = std::prev(calls_.end());
+            }
+
+            append(*call, entry.group);
+
+            // a fence covers the entire call, so nothing submitted after this entry may be folded into it
+            if (entry.fence) {
+                call->fence = entry.fence;
+                submit(*call);
+            }
+        }
+
+        for (auto& call : calls_) {
+            if (call.open) {
+                submit(call);
+            }
+        }
+
+        calls_.clear();
+        entries_.clear();
+    }
+
+    auto SubmitBatcher::end_frame() -> Stats {
+        if (!entries_.empty()) {
+            flush();
+        }
+
+        last_frame_stats_ = frame_stats_;
+        frame_stats_      = {};
+
+        log(ELogLvl::TRACE,
+            "Frame submitted {} command buffer(s) through {} submit info(s) in {} queue submit call(s)",
+            last_frame_stats_.command_buffers,
+            last_frame_stats_.submit_infos,
+            last_frame_stats_.submit_calls);
+
+        return last_frame_stats_;
+    }
+
+    auto SubmitBatcher::last_frame_stats() const -> Stats {
+        return last_frame_stats_;
+    }
+
+    void SubmitBatcher::append(Call& call, const Group& group) const {
+        // waits apply to a whole submit info, so an entry that waits can't be folded into work that came before it
+        // entries without waits are merged, which at worst delays the previous entry's signals until they're done too
+        const bool needs_new_group = call.groups.empty() || (!group.waits.empty() && (!call.groups.back().command_buffers.empty() ||
+                                                                                      !call.groups.back().signals.empty()));
+
+        if (needs_new_group) {
+            call.groups.push_back(group);
+            return;
+        }
+
+        auto& current = call.groups.back();
+        current.waits.insert(current.waits.end(), group.waits.begin(), group.waits.end());
+        current.command_buffers.insert(current.command_buffers.end(), group.command_buffers.begin(), group.command_buffers.end());
+        current.signals.insert(current.signals.end(), group.signals.begin(), group.signals.end());
+    }
+
+    void SubmitBatcher::submit(Call& call) {
+        std::vector<Queue::SubmitData> submits;
+        submits.reserve(call.groups.size());
+
+        for (const auto& group : call.groups) {
+            submits.push_back({
+                .command_buffers = group.command_buffers,
+                .waits           = group.waits,
+                .signals         = group.signals,
+            });
+
+            frame_stats_.command_buffers += cast<u32>(group.command_buffers.size());
+        }
+
+        call.queue->submit_batch(submits, call.fence);
+        call.open = false;
+
+        ++frame_stats_.submit_calls;
+        frame_stats_.submit_infos += cast<u32>(submits.size());
+    }
+
+    auto SubmitBatcher::signals_semaphore(const Call& call, const vk::Semaphore semaphore) const -> bool {
+        // the queue's own timeline is signalled implicitly by every call
+        if (call.queue->get_timeline().get_handle() == semaphore) {
+            return true;
+        }
+
+        return std::any_of(call.groups.begin(), call.groups.end(), [&](const Group& group) {
+            return std::any_of(group.signals.begin(), group.signals.end(), [&](const Queue::SemaphoreDependency& signal) {
+                return signal.semaphore == semaphore;
+            });
+        });
+    }
+}  // namespace sylk
@@ -0,0 +1,305 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/descriptor/bindless_table.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+#include <algorithm>
+#include <array>
+
+namespace sylk {
+    BindlessTable::BindlessTable(const vk::Device& device)
+        : device_(device)
+        , current_slot_(0) {}
+
+    void BindlessTable::create(const vk::PhysicalDevice physical_device, const u32 frame_count, DescriptorBuffer* descriptor_buffer) {
+        descriptor_buffer_ = descriptor_buffer;
+
+        const auto  properties = physical_device.getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceVulkan12Properties>();
+        const auto& limits     = properties.get<vk::PhysicalDeviceProperties2>().properties.limits;
+        const auto& uab_limits = properties.get<vk::PhysicalDeviceVulkan12Properties>();
+
+        // pools are bound by the update after bind limits, descriptor buffers by the regular ones
+        if (descriptor_buffer_) {
+            image_slots_.capacity   = std::min({MAX_IMAGES, limits.maxDescriptorSetSampledImages, limits.maxPerStageDescriptorSampledImages});
+            sampler_slots_.capacity = std::min({MAX_SAMPLERS, limits.maxDescriptorSetSamplers, limits.maxPerStageDescriptorSamplers});
+            buffer_slots_.capacity  = std::min({MAX_BUFFERS, limits.maxDescriptorSetStorageBuffers, limits.maxPerStageDescriptorStorageBuffers});
+        } else {
+            image_slots_.capacity   = std::min({MAX_IMAGES,
+                                                uab_limits.maxDescriptorSetUpdateAfterBindSampledImages,
+                                                uab_limits.maxPerStageDescriptorUpdateAfterBindSampledImages});
+            sampler_slots_.capacity = std::min({MAX_SAMPLERS,
+                                                uab_limits.maxDescriptorSetUpdateAfterBindSamplers,
+                                                uab_limits.maxPerStageDescriptorUpdateAfterBindSamplers});
+            buffer_slots_.capacity  = std::min({MAX_BUFFERS,
+                                                uab_limits.maxDescriptorSetUpdateAfterBindStorageBuffers,
+                                                uab_limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers});
+        }
+
+        for (auto* slots : {&image_slots_, &sampler_slots_, &buffer_slots_}) {
+            slots->retired.resize(frame_count);
+        }
+
+        const std::array bindings = {
+            vk::DescriptorSetLayoutBinding {
+                .binding         = IMAGE_BINDING,
+                .descriptorType  = vk::DescriptorType::eSampledImage,
+                .descriptorCount = image_slots_.capacity,
+                .stageFlags      = vk::ShaderStageFlagBits::eAll,
+            },
+            vk::DescriptorSetLayoutBinding {
+                .binding         = SAMPLER_BINDING,
+                .descriptorType  = vk::DescriptorType::eSampler,
+                .descriptorCount = sampler_slots_.capacity,
+                .stageFlags      = vk::ShaderStageFlagBits::eAll,
+            },
+            vk::DescriptorSetLayoutBinding {
+                .binding         = BUFFER_BINDING,
+                .descriptorType  = vk::DescriptorType::eStorageBuffer,
+                .descriptorCount = buffer_slots_.capacity,
+                .stageFlags      = vk::ShaderStageFlagBits::eAll,
+            },
+        };
+
+        // descriptor buffers can always be written while bound, update after bind only exists for pools
+        vk::DescriptorBindingFlags         binding_flags = vk::DescriptorBindingFlagBits::ePartiallyBound;
+        vk::DescriptorSetLayoutCreateFlags layout_flags  = vk::DescriptorSetLayoutCreateFlagBits::eDescriptorBufferEXT;
+
+        if (!descriptor_buffer_) {
+            binding_flags |= vk::DescriptorBindingFlagBits::eUpdateAfterBind | vk::DescriptorBindingFlagBits::eUpdateUnusedWhilePending;
+            layout_flags = vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool;
+        }
+
+        const std::array all_binding_flags = {binding_flags, binding_flags, binding_flags};
+
+        const auto flags_info = vk::DescriptorSetLayoutBindingFlagsCreateInfo().setBindingFlags(all_binding_flags);
+        const auto layout_info =
+            vk::DescriptorSetLayoutCreateInfo {
+                .pNext = &flags_info,
+                .flags = layout_flags,
+            }
+                .setBindings(bindings);
+
+        const auto [layout_result, layout] = device_.createDescriptorSetLayout(layout_info);
+        handle_result(layout_result, "Failed to create bindless descriptor set layout");
+        layout_ = layout;
+
+        if (descriptor_buffer_) {
+            allocation_ = descriptor_buffer_->allocate_persistent(layout_);
+            if (!allocation_) {
+                log(ELogLvl::CRITICAL, "Bindless table doesn't fit into the descriptor buffer");
+            }
+
+            log(ELogLvl::DEBUG,
+                "Created bindless table in the descriptor buffer with room for {} image(s), {} sampler(s) and {} buffer(s)",
+                image_slots_.capacity,
+                sampler_slots_.capacity,
+                buffer_slots_.capacity);
+            return;
+        }
+
+        const std::array pool_sizes = {
+            vk::DescriptorPoolSize {.type = vk::DescriptorType::eSampledImage, .descriptorCount = image_slots_.capacity},
+            vk::DescriptorPoolSize {     .type = vk::DescriptorType::eSampler, .descriptorCount = sampler_slots_.capacity},
+            vk::DescriptorPoolSize {.type = vk::DescriptorType::eStorageBuffer, .descriptorCount = buffer_slots_.capacity},
+        };
+
+        const auto pool_info =
+            vk::DescriptorPoolCreateInfo {
+                .flags   = vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind,
+                .maxSets = 1,
+            }
+                .setPoolSizes(pool_sizes);
+
+        const auto [pool_result, pool] = device_.createDescriptorPool(pool_info);
+        handle_result(pool_result, "Failed to create bindless descriptor pool");
+        pool_ = pool;
+
+        const auto alloc_info = vk::DescriptorSetAllocateInfo {.descriptorPool = pool_}.setSetLayouts(layout_);
+
+        const auto [set_result, sets] = device_.allocateDescriptorSets(alloc_info);
+        handle_result(set_result, "Failed to allocate bindless descriptor set");
+        set_ = sets.front();
+
+        log(ELogLvl::DEBUG,
+            "Created bindless table with room for {} image(s), {} sampler(s) and {} buffer(s)",
+            image_slots_.capacity,
+            sampler_slots_.capacity,
+            buffer_slots_.capacity);
+    }
+
+    void BindlessTable::destroy() {
+        // the set goes away with its pool, an allocation in a descriptor buffer with the buffer
+        if (pool_) {
+            device_.destroyDescriptorPool(pool_);
+        }
+        device_.destroyDescriptorSetLayout(layout_);
+
+        pool_       = nullptr;
+        layout_     = nullptr;
+        set_        = nullptr;
+        allocation_ = {};
+
+        log(ELogLvl::TRACE, "Destroyed bindless table");
+    }
+
+    void BindlessTable::begin_frame(const u32 frame_slot) {
+        current_slot_ = frame_slot;
+
+        // the last frame that could have used these is done now
+        for (auto* slots : {&image_slots_, &sampler_slots_, &buffer_slots_}) {
+            auto& retired = slots->retired[current_slot_];
+            slots->free.insert(slots->free.end(), retired.begin(), retired.end());
+            retired.clear();
+        }
+    }
+
+    auto BindlessTable::add_image(const vk::ImageView view, const vk::ImageLayout layout) -> u32 {
+        const u32 index = claim(image_slots_, "image");
+        pending_images_.emplace_back(index, vk::DescriptorImageInfo {.imageView = view, .imageLayout = layout});
+
+        return index;
+    }
+
+    auto BindlessTable::add_sampler(const vk::Sampler sampler) -> u32 {
+        const u32 index = claim(sampler_slots_, "sampler");
+        pending_samplers_.emplace_back(index, vk::DescriptorImageInfo {.sampler = sampler});
+
+        return index;
+    }
+
+    auto BindlessTable::add_buffer(const vk::Buffer buffer, const vk::DeviceSize offset, const vk::DeviceSize range) -> u32 {
+        const u32 index = claim(buffer_slots_, "buffer");
+        pending_buffers_.emplace_back(index, vk::DescriptorBufferInfo {.buffer = buffer, .offset = offset, .range = range});
+
+        return index;
+    }
+
+    void BindlessTable::release_image(const u32 index) {
+        release(image_slots_, index);
+    }
+
+    void BindlessTable::release_sampler(const u32 index) {
+        release(sampler_slots_, index);
+    }
+
+    void BindlessTable::release_buffer(const u32 index) {
+        release(buffer_slots_, index);
+    }
+
+    void BindlessTable::flush() {
+        if (pending_images_.empty() && pending_samplers_.empty() && pending_buffers_.empty()) {
+            return;
+        }
+
+        if (descriptor_buffer_) {
+            write_pending_to_buffer();
+            return;
+        }
+
+        std::vector<vk::WriteDescriptorSet> writes;
+        writes.reserve(pending_images_.size() + pending_samplers_.size() + pending_buffers_.size());
+
+        for (const auto& [index, info] : pending_images_) {
+            writes.push_back({
+                .dstSet          = set_,
+                .dstBinding      = IMAGE_BINDING,
+                .dstArrayElement = index,
+                .descriptorCount = 1,
+                .descriptorType  = vk::DescriptorType::eSampledImage,
+                .pImageInfo      = &info,
+            });
+        }
+
+        for (const auto& [index, info] : pending_samplers_) {
+            writes.push_back({
+                .dstSet          = set_,
+                .dstBinding      = SAMPLER_BINDING,
+                .dstArrayElement = index,
+                .descriptorCount = 1,
+                .descriptorType  = vk::DescriptorType::eSampler,
+                .pImageInfo      = &info,
+            });
+        }
+
+        for (const auto& [index, info] : pending_buffers_) {
+            writes.push_back({
+                .dstSet          = set_,
+                .dstBinding      = BUFFER_BINDING,
+                .dstArrayElement = index,
+                .descriptorCount = 1,
+                .descriptorType  = vk::DescriptorType::eStorageBuffer,
+                .pBufferInfo     = &info,
+            });
+        }
+
+        device_.updateDescriptorSets(writes, nullptr);
+
+        pending_images_.clear();
+        pending_samplers_.clear();
+        pending_buffers_.clear();
+    }
+
+    void BindlessTable::bind(const vk::CommandBuffer cmd, const vk::PipelineBindPoint bind_point, const vk::PipelineLayout layout) const {
+        if (descriptor_buffer_) {
+            descriptor_buffer_->set_offset(cmd, bind_point, layout, SET, allocation_);
+            return;
+        }
+
+        cmd.bindDescriptorSets(bind_point, layout, SET, set_, nullptr);
+    }
+
+    auto BindlessTable::layout() const -> vk::DescriptorSetLayout {
+        return layout_;
+    }
+
+    auto BindlessTable::valid() const -> bool {
+        return static_cast<bool>(set_) || static_cast<bool>(allocation_);
+    }
+
+    auto BindlessTable::claim(Slots& slots, const char* kind) -> u32 {
+        if (!slots.free.empty()) {
+            const u32 index = slots.free.back();
+            slots.free.pop_back();
+            return index;
+        }
+
+        if (slots.next == slots.capacity) {
+            log(ELogLvl::CRITICAL, "Bindless table ran out of {} slots ({})", kind, slots.capacity);
+        }
+
+        return slots.next++;
+    }
+
+    void BindlessTable::write_pending_to_buffer() {
+        for (const auto& [index, info] : pending_images_) {
+            descriptor_buffer_->write_image(allocation_, layout_, IMAGE_BINDING, vk::DescriptorType::eSampledImage, info, index);
+        }
+
+        for (const auto& [index, info] : pending_samplers_) {
+            descriptor_buffer_->write_image(allocation_, layout_, SAMPLER_BINDING, vk::DescriptorType::eSampler, info, index);
+        }
+
+        for (const auto& [index, info] : pending_buffers_) {
+            const auto address = device_.getBufferAddress(vk::BufferDeviceAddressInfo {.buffer = info.buffer}) + info.offset;
+            descriptor_buffer_->write_buffer(allocation_,
+                                             layout_,
+                                             BUFFER_BINDING,
+                                             vk::DescriptorType::eStorageBuffer,
+                                             address,
+                                             info.range,
+                                             index);
+        }
+
+        pending_images_.clear();
+        pending_samplers_.clear();
+        pending_buffers_.clear();
+    }
+
+    void BindlessTable::release(Slots& slots, const u32 index) const {
+        // the descriptor itself is left alone, partially bound arrays don't care as long as nothing reads it
+        slots.retired[current_slot_].push_back(index);
+    }
+}  // namespace sylk
@@ -0,0 +1,143 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/descriptor/descriptor_allocator.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // pools double in size every time an arena runs out, until they hit the cap
+    constexpr sylk::u32 INITIAL_SETS_PER_POOL = 64;
+    constexpr sylk::u32 MAX_SETS_PER_POOL     = 4096;
+}  // namespace
+
+namespace sylk {
+    DescriptorAllocator::DescriptorAllocator(const vk::Device& device)
+        : device_(device)
+        , current_slot_(0) {}
+
+    void DescriptorAllocator::create(const u32 frame_count, const std::span<const PoolRatio> ratios) {
+        ratios_.assign(ratios.begin(), ratios.end());
+        frame_arenas_.assign(frame_count, Arena {.sets_per_pool = INITIAL_SETS_PER_POOL});
+        persistent_arena_ = Arena {.sets_per_pool = INITIAL_SETS_PER_POOL};
+
+        // one pool per arena up front, so the first frames don't have to create any
+        for (auto& arena : frame_arenas_) {
+            arena.ready.push_back(create_pool(arena.sets_per_pool));
+        }
+        persistent_arena_.ready.push_back(create_pool(persistent_arena_.sets_per_pool));
+
+        log(ELogLvl::TRACE, "Created descriptor allocator for {} frame(s)", frame_count);
+    }
+
+    void DescriptorAllocator::destroy() {
+        for (auto& arena : frame_arenas_) {
+            destroy(arena);
+        }
+        destroy(persistent_arena_);
+        frame_arenas_.clear();
+
+        log(ELogLvl::TRACE, "Destroyed descriptor pools");
+    }
+
+    void DescriptorAllocator::begin_frame(const u32 frame_slot) {
+        current_slot_ = frame_slot;
+        reset(frame_arenas_[current_slot_]);
+    }
+
+    auto DescriptorAllocator::allocate(const vk::DescriptorSetLayout layout) -> vk::DescriptorSet {
+        return allocate_from(frame_arenas_[current_slot_], layout);
+    }
+
+    auto DescriptorAllocator::allocate_persistent(const vk::DescriptorSetLayout layout) -> vk::DescriptorSet {
+        return allocate_from(persistent_arena_, layout);
+    }
+
+    auto DescriptorAllocator::pool_count() const -> u64 {
+        u64 count = persistent_arena_.ready.size() + persistent_arena_.full.size();
+        for (const auto& arena : frame_arenas_) {
+            count += arena.ready.size() + arena.full.size();
+        }
+
+        return count;
+    }
+
+    auto DescriptorAllocator::allocate_from(Arena& arena, const vk::DescriptorSetLayout layout) -> vk::DescriptorSet {
+        auto alloc_info = vk::DescriptorSetAllocateInfo {.descriptorPool = acquire_pool(arena)}.setSetLayouts(layout);
+
+        auto [result, sets] = device_.allocateDescriptorSets(alloc_info);
+
+        // running out is expected, the pool is parked until its next reset and a fresh one gets a second try
+        if (result == vk::Result::eErrorOutOfPoolMemory || result == vk::Result::eErrorFragmentedPool) {
+            arena.full.push_back(arena.ready.back());
+            arena.ready.pop_back();
+
+            alloc_info.descriptorPool = acquire_pool(arena);
+
+            auto retry = device_.allocateDescriptorSets(alloc_info);
+            result     = retry.result;
+            sets       = std::move(retry.value);
+        }
+
+        handle_result(result, "Failed to allocate descriptor set", ELogLvl::ERROR);
+
+        return (sets.empty() ? vk::DescriptorSet {} : sets.front());
+    }
+
+    auto DescriptorAllocator::acquire_pool(Arena& arena) -> vk::DescriptorPool {
+        if (!arena.ready.empty()) {
+            return arena.ready.back();
+        }
+
+        arena.sets_per_pool = std::min(arena.sets_per_pool * 2, MAX_SETS_PER_POOL);
+        arena.ready.push_back(create_pool(arena.sets_per_pool));
+
+        log(ELogLvl::DEBUG, "Descriptor arena grew to {} pool(s)", arena.ready.size() + arena.full.size());
+
+        return arena.ready.back();
+    }
+
+    auto DescriptorAllocator::create_pool(const u32 set_count) const -> vk::DescriptorPool {
+        std::vector<vk::DescriptorPoolSize> pool_sizes;
+        for (const auto& ratio : ratios_) {
+            pool_sizes.push_back({
+                .type            = ratio.type,
+                .descriptorCount = std::max(1u, cast<u32>(std::ceil(ratio.per_set * cast<f32>(set_count)))),
+            });
+        }
+
+        // no free descriptor set flag, sets are only ever released by resetting the whole pool
+        const auto pool_info = vk::DescriptorPoolCreateInfo {.maxSets = set_count}.setPoolSizes(pool_sizes);
+
+        const auto [result, pool] = device_.createDescriptorPool(pool_info);
+        handle_result(result, "Failed to create descriptor pool", ELogLvl::ERROR);
+
+        return pool;
+    }
+
+    void DescriptorAllocator::reset(Arena& arena) const {
+        arena.ready.insert(arena.ready.end(), arena.full.begin(), arena.full.end());
+        arena.full.clear();
+
+        for (const auto pool : arena.ready) {
+            device_.resetDescriptorPool(pool);
+        }
+    }
+
+    void DescriptorAllocator::destroy(Arena& arena) const {
+        for (const auto pool : arena.ready) {
+            device_.destroyDescriptorPool(pool);
+        }
+
+        for (const auto pool : arena.full) {
+            device_.destroyDescriptorPool(pool);
+        }
+
+        arena.ready.clear();
+        arena.full.clear();
+    }
+}  // namespace sylk
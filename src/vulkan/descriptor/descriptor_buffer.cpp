@@ -0,0 +1,230 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/descriptor/descriptor_buffer.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+#include <magic_enum/magic_enum.hpp>
+
+namespace {
+    auto align_up(const vk::DeviceSize value, const vk::DeviceSize alignment) -> vk::DeviceSize {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}  // namespace
+
+namespace sylk {
+    DescriptorBuffer::DescriptorBuffer(const vk::Device& device)
+        : device_(device)
+        , current_slot_(0) {}
+
+    void DescriptorBuffer::create(const vk::PhysicalDevice physical_device,
+                                  const u32                frame_count,
+                                  const vk::DeviceSize     frame_size,
+                                  const vk::DeviceSize     persistent_size) {
+        const auto properties =
+            physical_device.getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceDescriptorBufferPropertiesEXT>();
+        properties_ = properties.get<vk::PhysicalDeviceDescriptorBufferPropertiesEXT>();
+
+        const auto alignment          = properties_.descriptorBufferOffsetAlignment;
+        const auto aligned_frame      = align_up(frame_size, alignment);
+        const auto aligned_persistent = align_up(persistent_size, alignment);
+        const auto total_size         = aligned_frame * frame_count + aligned_persistent;
+
+        frame_regions_.clear();
+        for (u32 i = 0; i < frame_count; ++i) {
+            frame_regions_.push_back({.begin = aligned_frame * i, .end = aligned_frame * (i + 1), .head = aligned_frame * i});
+        }
+
+        persistent_region_ = {.begin = aligned_frame * frame_count, .end = total_size, .head = aligned_frame * frame_count};
+
+        // samplers and resources share the buffer, so the whole thing takes up a single binding of each kind
+        buffer_.create({
+            .data_to_map        = nullptr,
+            .persistent_mapping = true,
+            .device             = device_,
+            .physical_device    = physical_device,
+            .buffer_size        = total_size,
+            .buffer_usage_flags = vk::BufferUsageFlagBits::eResourceDescriptorBufferEXT |
+                                  vk::BufferUsageFlagBits::eSamplerDescriptorBufferEXT |
+                                  vk::BufferUsageFlagBits::eShaderDeviceAddress,
+            .property_flags     = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+        });
+
+        address_ = buffer_.device_address(device_);
+
+        log(ELogLvl::DEBUG,
+            "Created descriptor buffer of {} KiB for {} frame(s), {} KiB persistent",
+            total_size / 1024,
+            frame_count,
+            aligned_persistent / 1024);
+    }
+
+    void DescriptorBuffer::destroy() {
+        buffer_.destroy_with(device_);
+        address_ = 0;
+
+        layout_sizes_.clear();
+        binding_offsets_.clear();
+
+        log(ELogLvl::TRACE, "Destroyed descriptor buffer");
+    }
+
+    void DescriptorBuffer::begin_frame(const u32 frame_slot) {
+        current_slot_ = frame_slot;
+
+        auto& region = frame_regions_[current_slot_];
+        region.head  = region.begin;
+    }
+
+    auto DescriptorBuffer::allocate(const vk::DescriptorSetLayout layout) -> Allocation {
+        return allocate_from(frame_regions_[current_slot_], layout);
+    }
+
+    auto DescriptorBuffer::allocate_persistent(const vk::DescriptorSetLayout layout) -> Allocation {
+        return allocate_from(persistent_region_, layout);
+    }
+
+    void DescriptorBuffer::write_buffer(const Allocation&             allocation,
+                                        const vk::DescriptorSetLayout layout,
+                                        const u32                     binding,
+                                        const vk::DescriptorType      type,
+                                        const vk::DeviceAddress       address,
+                                        const vk::DeviceSize          range,
+                                        const u32                     array_element) {
+        const auto address_info = vk::DescriptorAddressInfoEXT {.address = address, .range = range};
+
+        auto get_info = vk::DescriptorGetInfoEXT {.type = type};
+        switch (type) {
+        case vk::DescriptorType::eUniformBuffer:
+            get_info.data.pUniformBuffer = &address_info;
+            break;
+        case vk::DescriptorType::eStorageBuffer:
+            get_info.data.pStorageBuffer = &address_info;
+            break;
+        default:
+            log(ELogLvl::ERROR, "Descriptor type {} isn't a buffer", magic_enum::enum_name(type));
+            return;
+        }
+
+        write(allocation, layout, binding, array_element, get_info);
+    }
+
+    void DescriptorBuffer::write_image(const Allocation&              allocation,
+                                       const vk::DescriptorSetLayout  layout,
+                                       const u32                      binding,
+                                       const vk::DescriptorType       type,
+                                       const vk::DescriptorImageInfo& image_info,
+                                       const u32                      array_element) {
+        auto get_info = vk::DescriptorGetInfoEXT {.type = type};
+        switch (type) {
+        case vk::DescriptorType::eSampler:
+            get_info.data.pSampler = &image_info.sampler;
+            break;
+        case vk::DescriptorType::eCombinedImageSampler:
+            get_info.data.pCombinedImageSampler = &image_info;
+            break;
+        case vk::DescriptorType::eSampledImage:
+            get_info.data.pSampledImage = &image_info;
+            break;
+        case vk::DescriptorType::eStorageImage:
+            get_info.data.pStorageImage = &image_info;
+            break;
+        default:
+            log(ELogLvl::ERROR, "Descriptor type {} isn't an image", magic_enum::enum_name(type));
+            return;
+        }
+
+        write(allocation, layout, binding, array_element, get_info);
+    }
+
+    void DescriptorBuffer::bind(const vk::CommandBuffer cmd) const {
+        const auto binding_info = vk::DescriptorBufferBindingInfoEXT {
+            .address = address_,
+            .usage   = vk::BufferUsageFlagBits::eResourceDescriptorBufferEXT | vk::BufferUsageFlagBits::eSamplerDescriptorBufferEXT,
+        };
+
+        cmd.bindDescriptorBuffersEXT(binding_info);
+    }
+
+    void DescriptorBuffer::set_offset(const vk::CommandBuffer     cmd,
+                                      const vk::PipelineBindPoint bind_point,
+                                      const vk::PipelineLayout    layout,
+                                      const u32                   set,
+                                      const Allocation&           allocation) const {
+        // always buffer 0, it's the only one ever bound
+        const u32 buffer_index = 0;
+        cmd.setDescriptorBufferOffsetsEXT(bind_point, layout, set, buffer_index, allocation.offset);
+    }
+
+    auto DescriptorBuffer::valid() const -> bool {
+        return address_ != 0;
+    }
+
+    auto DescriptorBuffer::allocate_from(Region& region, const vk::DescriptorSetLayout layout) -> Allocation {
+        const auto offset = align_up(region.head, properties_.descriptorBufferOffsetAlignment);
+        const auto size   = layout_size(layout);
+
+        if (offset + size > region.end) {
+            log(ELogLvl::ERROR, "Descriptor buffer region is full, {} more byte(s) don't fit", size);
+            return {};
+        }
+
+        region.head = offset + size;
+
+        return {
+            .offset = offset,
+            .data   = static_cast<u8*>(buffer_.mapped_memory()) + offset,
+        };
+    }
+
+    auto DescriptorBuffer::layout_size(const vk::DescriptorSetLayout layout) -> vk::DeviceSize {
+        const auto [it, inserted] = layout_sizes_.try_emplace(layout, 0);
+        if (inserted) {
+            it->second = device_.getDescriptorSetLayoutSizeEXT(layout);
+        }
+
+        return it->second;
+    }
+
+    auto DescriptorBuffer::descriptor_size(const vk::DescriptorType type) const -> u64 {
+        switch (type) {
+        case vk::DescriptorType::eSampler:
+            return properties_.samplerDescriptorSize;
+        case vk::DescriptorType::eCombinedImageSampler:
+            return properties_.combinedImageSamplerDescriptorSize;
+        case vk::DescriptorType::eSampledImage:
+            return properties_.sampledImageDescriptorSize;
+        case vk::DescriptorType::eStorageImage:
+            return properties_.storageImageDescriptorSize;
+        case vk::DescriptorType::eUniformBuffer:
+            return properties_.uniformBufferDescriptorSize;
+        case vk::DescriptorType::eStorageBuffer:
+            return properties_.storageBufferDescriptorSize;
+        default:
+            return 0;
+        }
+    }
+
+    void DescriptorBuffer::write(const Allocation&               allocation,
+                                 const vk::DescriptorSetLayout   layout,
+                                 const u32                       binding,
+                                 const u32                       array_element,
+                                 const vk::DescriptorGetInfoEXT& get_info) {
+        if (!allocation) {
+            return;
+        }
+
+        const auto [it, inserted] = binding_offsets_.try_emplace({layout, binding}, 0);
+        if (inserted) {
+            it->second = device_.getDescriptorSetLayoutBindingOffsetEXT(layout, binding);
+        }
+
+        // array elements are tightly packed at the descriptor size of their type
+        const auto size   = descriptor_size(get_info.type);
+        const auto offset = it->second + size * array_element;
+
+        device_.getDescriptorEXT(get_info, size, allocation.data + offset);
+    }
+}  // namespace sylk
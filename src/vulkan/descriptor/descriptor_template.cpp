@@ -0,0 +1,100 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/descriptor/descriptor_template.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+namespace {
+    // what a single descriptor of the type takes up in the packed struct
+    auto packed_size(const vk::DescriptorType type) -> sylk::u64 {
+        switch (type) {
+        case vk::DescriptorType::eUniformBuffer:
+        case vk::DescriptorType::eStorageBuffer:
+        case vk::DescriptorType::eUniformBufferDynamic:
+        case vk::DescriptorType::eStorageBufferDynamic:
+            return sizeof(vk::DescriptorBufferInfo);
+        case vk::DescriptorType::eUniformTexelBuffer:
+        case vk::DescriptorType::eStorageTexelBuffer:
+            return sizeof(vk::BufferView);
+        default:
+            return sizeof(vk::DescriptorImageInfo);
+        }
+    }
+}  // namespace
+
+namespace sylk {
+    DescriptorTemplate::DescriptorTemplate(const vk::Device& device)
+        : device_(device) {}
+
+    void DescriptorTemplate::create(const PipelineLayoutCache::Layout& layout,
+                                    const u32                          set,
+                                    const bool                         push,
+                                    const vk::PipelineBindPoint        bind_point) {
+        pipeline_layout_ = layout.pipeline_layout;
+        set_             = set;
+        data_size_       = 0;
+
+        std::vector<vk::DescriptorUpdateTemplateEntry> entries;
+        for (const auto& binding : layout.set_bindings.at(set)) {
+            if (binding.descriptorCount == 0) {
+                log(ELogLvl::ERROR, "Binding {} of set {} is a runtime array and can't be part of an update template", binding.binding, set);
+                continue;
+            }
+
+            const u64 stride = packed_size(binding.descriptorType);
+
+            entries.push_back({
+                .dstBinding      = binding.binding,
+                .dstArrayElement = 0,
+                .descriptorCount = binding.descriptorCount,
+                .descriptorType  = binding.descriptorType,
+                .offset          = data_size_,
+                .stride          = stride,
+            });
+
+            data_size_ += stride * binding.descriptorCount;
+        }
+
+        const auto template_info =
+            vk::DescriptorUpdateTemplateCreateInfo {
+                .templateType        = (push ? vk::DescriptorUpdateTemplateType::ePushDescriptorsKHR
+                                             : vk::DescriptorUpdateTemplateType::eDescriptorSet),
+                .descriptorSetLayout = layout.set_layouts.at(set),
+                .pipelineBindPoint   = bind_point,
+                .pipelineLayout      = layout.pipeline_layout,
+                .set                 = set,
+            }
+                .setDescriptorUpdateEntries(entries);
+
+        const auto [result, update_template] = device_.createDescriptorUpdateTemplate(template_info);
+        handle_result(result, "Failed to create descriptor update template", ELogLvl::ERROR);
+        template_ = update_template;
+
+        log(ELogLvl::TRACE, "Created {} template for set {} with {} entries", (push ? "push descriptor" : "descriptor update"), set, entries.size());
+    }
+
+    void DescriptorTemplate::destroy() {
+        device_.destroyDescriptorUpdateTemplate(template_);
+        template_ = nullptr;
+    }
+
+    auto DescriptorTemplate::data_size() const -> u64 {
+        return data_size_;
+    }
+
+    auto DescriptorTemplate::valid() const -> bool {
+        return static_cast<bool>(template_);
+    }
+
+    auto DescriptorTemplate::matches(const u64 size) const -> bool {
+        // a mismatch would have the driver read past the struct, so nothing is written at all
+        if (size != data_size_) {
+            log(ELogLvl::ERROR, "Descriptor struct is {} bytes, the template for set {} expects {}", size, set_, data_size_);
+            return false;
+        }
+
+        return true;
+    }
+}  // namespace sylk
@@ -20,7 +20,12 @@ namespace sylk {
 
         const auto mem_reqs = data.device.getBufferMemoryRequirements(buffer_);
 
+        // buffers whose address is taken need memory that was allocated with that in mind
+        const auto alloc_flags = vk::MemoryAllocateFlagsInfo {.flags = vk::MemoryAllocateFlagBits::eDeviceAddress};
+        const bool has_address = static_cast<bool>(data.buffer_usage_flags & vk::BufferUsageFlagBits::eShaderDeviceAddress);
+
         const auto alloc_info = vk::MemoryAllocateInfo {
+            .pNext           = (has_address ? &alloc_flags : nullptr),
             .allocationSize  = mem_reqs.size,
             .memoryTypeIndex = find_memtype(data.physical_device, mem_reqs.memoryTypeBits, data.property_flags),
         };
@@ -68,37 +73,14 @@ namespace sylk {
         return buffer_memory_;
     }
 
-    void Buffer::copy_onto(Buffer::CopyData data) const {
-        const auto cmd_buffer_alloc_info = vk::CommandBufferAllocateInfo {
-            .commandPool        = data.pool,
-            .level              = vk::CommandBufferLevel::ePrimary,
-            .commandBufferCount = 1,
-        };
-
-        const auto [cmd_buffer_result, cmd_buffers] = data.device.allocateCommandBuffers(cmd_buffer_alloc_info);
-        handle_result(cmd_buffer_result, "Failed to allocate command buffer");
-
-        const auto cmd_buffer_begin_info = vk::CommandBufferBeginInfo {
-            .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit,
-        };
-
-        const auto cmd_buffer = cmd_buffers[0];
-        handle_result(cmd_buffer.begin(cmd_buffer_begin_info), "Failed to begin recording command buffer");
-
+    void Buffer::copy_onto(const vk::CommandBuffer cmd_buffer, const Buffer::CopyData data) const {
         const auto copy_region = vk::BufferCopy {
-            .size = data.size,
+            .srcOffset = data.src_offset,
+            .dstOffset = data.dst_offset,
+            .size      = data.size,
         };
 
         cmd_buffer.copyBuffer(buffer_, data.target, copy_region);
-
-        handle_result(cmd_buffer.end(), "Failed to stop recording command buffer");
-
-        const auto submit_info = vk::SubmitInfo().setCommandBuffers(cmd_buffer);
-
-        handle_result(data.queue.submit(submit_info), "Failed to submit buffer transfer command to transfer queue");
-        handle_result(data.queue.waitIdle(), "Device error");
-
-        data.device.freeCommandBuffers(data.pool, cmd_buffer);
     }
 
     void Buffer::destroy_with(vk::Device device) {
@@ -111,6 +93,10 @@ namespace sylk {
         return mapped_memory_;
     }
 
+    auto Buffer::device_address(const vk::Device device) const -> vk::DeviceAddress {
+        return device.getBufferAddress(vk::BufferDeviceAddressInfo {.buffer = buffer_});
+    }
+
     void Buffer::pass_data(void* data_to_pass, size_t size_in_bytes) {
         std::memcpy(mapped_memory_, data_to_pass, size_in_bytes);
     }
@@ -0,0 +1,93 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/memory/streaming_buffer.hpp>
+
+namespace {
+    // keeps every region aligned for any use the buffer may be bound for, storage buffers want at most 256
+    constexpr vk::DeviceSize REGION_ALIGNMENT = 256;
+
+    auto align_up(const vk::DeviceSize value, const vk::DeviceSize alignment) -> vk::DeviceSize {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}  // namespace
+
+namespace sylk {
+    StreamingBuffer::StreamingBuffer(const vk::Device& device)
+        : device_(device)
+        , current_slot_(0) {}
+
+    void StreamingBuffer::create(const vk::PhysicalDevice   physical_device,
+                                 const vk::BufferUsageFlags usage,
+                                 const u32                  frame_count,
+                                 const vk::DeviceSize       frame_size) {
+        frame_size_ = align_up(frame_size, REGION_ALIGNMENT);
+
+        frame_regions_.clear();
+        for (u32 i = 0; i < frame_count; ++i) {
+            frame_regions_.push_back({.begin = frame_size_ * i, .end = frame_size_ * (i + 1), .head = frame_size_ * i});
+        }
+
+        buffer_.create({
+            .data_to_map        = nullptr,
+            .persistent_mapping = true,
+            .device             = device_,
+            .physical_device    = physical_device,
+            .buffer_size        = frame_size_ * frame_count,
+            .buffer_usage_flags = usage,
+            .property_flags     = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+        });
+
+        log(ELogLvl::DEBUG, "Created streaming buffer of {} KiB for {} frame(s)", frame_size_ * frame_count / 1024, frame_count);
+    }
+
+    void StreamingBuffer::destroy() {
+        buffer_.destroy_with(device_);
+        frame_regions_.clear();
+
+        log(ELogLvl::TRACE, "Destroyed streaming buffer");
+    }
+
+    void StreamingBuffer::begin_frame(const u32 frame_slot) {
+        current_slot_ = frame_slot;
+
+        auto& region = frame_regions_[current_slot_];
+        region.head  = region.begin;
+    }
+
+    auto StreamingBuffer::allocate(const vk::DeviceSize size, const vk::DeviceSize alignment) -> Allocation {
+        auto&      region = frame_regions_[current_slot_];
+        const auto offset = align_up(region.head, alignment);
+
+        if (offset + size > region.end) {
+            log(ELogLvl::ERROR, "Streaming buffer region is full, {} more byte(s) don't fit", size);
+            return {};
+        }
+
+        region.head = offset + size;
+
+        return {
+            .offset = offset,
+            .data   = static_cast<u8*>(buffer_.mapped_memory()) + offset,
+        };
+    }
+
+    auto StreamingBuffer::vk_buffer() const -> vk::Buffer {
+        return buffer_.vk_buffer();
+    }
+
+    auto StreamingBuffer::frame_size() const -> vk::DeviceSize {
+        return frame_size_;
+    }
+
+    auto StreamingBuffer::used() const -> vk::DeviceSize {
+        const auto& region = frame_regions_[current_slot_];
+        return region.head - region.begin;
+    }
+
+    auto StreamingBuffer::valid() const -> bool {
+        return !frame_regions_.empty();
+    }
+}  // namespace sylk
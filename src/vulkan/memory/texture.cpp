@@ -0,0 +1,130 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/memory/texture.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+#include <stdexcept>
+
+namespace sylk {
+    void Texture::create(const CreateData data) {
+        extent_ = data.extent;
+
+        const auto image_info = vk::ImageCreateInfo {
+            .imageType     = vk::ImageType::e2D,
+            .format        = data.format,
+            .extent        = {.width = extent_.width, .height = extent_.height, .depth = 1},
+            .mipLevels     = 1,
+            .arrayLayers   = 1,
+            .samples       = vk::SampleCountFlagBits::e1,
+            .tiling        = vk::ImageTiling::eOptimal,
+            .usage         = data.usage,
+            .sharingMode   = vk::SharingMode::eExclusive,
+            .initialLayout = vk::ImageLayout::eUndefined,
+        };
+
+        const auto [image_result, image] = data.device.createImage(image_info);
+        handle_result(image_result, "Failed to create image");
+        image_ = image;
+
+        const auto mem_reqs = data.device.getImageMemoryRequirements(image_);
+
+        const auto alloc_info = vk::MemoryAllocateInfo {
+            .allocationSize  = mem_reqs.size,
+            .memoryTypeIndex = find_memtype(data.physical_device, mem_reqs.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal),
+        };
+
+        const auto [alloc_result, mem] = data.device.allocateMemory(alloc_info);
+        handle_result(alloc_result, "Failed to allocate device memory");
+        image_memory_ = mem;
+
+        handle_result(data.device.bindImageMemory(image_, image_memory_, 0), "Failed to bind image memory");
+
+        const auto view_info = vk::ImageViewCreateInfo {
+            .image            = image_,
+            .viewType         = vk::ImageViewType::e2D,
+            .format           = data.format,
+            .subresourceRange = {.aspectMask = vk::ImageAspectFlagBits::eColor, .levelCount = 1, .layerCount = 1},
+        };
+
+        const auto [view_result, view] = data.device.createImageView(view_info);
+        handle_result(view_result, "Failed to create image view");
+        view_ = view;
+    }
+
+    auto Texture::find_memtype(vk::PhysicalDevice physical_device, u32 type_filter, vk::MemoryPropertyFlags properties) -> u32 {
+        const auto mem_properties = physical_device.getMemoryProperties();
+
+        for (u32 i = 0; i < mem_properties.memoryTypeCount; ++i) {
+            if ((type_filter & (1 << i)) && (mem_properties.memoryTypes[i].propertyFlags & properties) == properties) {
+                return i;
+            }
+        }
+
+        throw std::runtime_error("Failed to find suitable image memory type on this device");
+    }
+
+    void Texture::upload(const vk::CommandBuffer cmd_buffer, const vk::Buffer staging_buffer, const vk::DeviceSize offset) const {
+        const auto subresource_range = vk::ImageSubresourceRange {
+            .aspectMask = vk::ImageAspectFlagBits::eColor,
+            .levelCount = 1,
+            .layerCount = 1,
+        };
+
+        // whatever was in the image before is thrown away, the copy overwrites all of it
+        const auto to_transfer = vk::ImageMemoryBarrier2 {
+            .srcStageMask     = vk::PipelineStageFlagBits2::eNone,
+            .srcAccessMask    = vk::AccessFlagBits2::eNone,
+            .dstStageMask     = vk::PipelineStageFlagBits2::eCopy,
+            .dstAccessMask    = vk::AccessFlagBits2::eTransferWrite,
+            .oldLayout        = vk::ImageLayout::eUndefined,
+            .newLayout        = vk::ImageLayout::eTransferDstOptimal,
+            .image            = image_,
+            .subresourceRange = subresource_range,
+        };
+
+        cmd_buffer.pipelineBarrier2(vk::DependencyInfo().setImageMemoryBarriers(to_transfer));
+
+        // zero row length and image height mean the texels are tightly packed
+        const auto copy_region = vk::BufferImageCopy {
+            .bufferOffset     = offset,
+            .imageSubresource = {.aspectMask = vk::ImageAspectFlagBits::eColor, .layerCount = 1},
+            .imageExtent      = {.width = extent_.width, .height = extent_.height, .depth = 1},
+        };
+
+        cmd_buffer.copyBufferToImage(staging_buffer, image_, vk::ImageLayout::eTransferDstOptimal, copy_region);
+
+        const auto to_shader_read = vk::ImageMemoryBarrier2 {
+            .srcStageMask     = vk::PipelineStageFlagBits2::eCopy,
+            .srcAccessMask    = vk::AccessFlagBits2::eTransferWrite,
+            .dstStageMask     = vk::PipelineStageFlagBits2::eFragmentShader,
+            .dstAccessMask    = vk::AccessFlagBits2::eShaderSampledRead,
+            .oldLayout        = vk::ImageLayout::eTransferDstOptimal,
+            .newLayout        = vk::ImageLayout::eShaderReadOnlyOptimal,
+            .image            = image_,
+            .subresourceRange = subresource_range,
+        };
+
+        cmd_buffer.pipelineBarrier2(vk::DependencyInfo().setImageMemoryBarriers(to_shader_read));
+    }
+
+    void Texture::destroy_with(vk::Device device) {
+        device.destroyImageView(view_);
+        device.destroyImage(image_);
+        device.freeMemory(image_memory_);
+    }
+
+    auto Texture::vk_image() const -> vk::Image {
+        return image_;
+    }
+
+    auto Texture::view() const -> vk::ImageView {
+        return view_;
+    }
+
+    auto Texture::extent() const -> vk::Extent2D {
+        return extent_;
+    }
+}  // namespace sylk
@@ -0,0 +1,170 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/pipeline/compute_pipeline.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+constexpr const char* DEFAULT_SHADER_ENTRY_NAME = "main";
+
+namespace sylk {
+    ComputePipeline::ComputePipeline(const vk::Device& device, ShaderModuleCache& shader_modules)
+        : device_(device)
+        , shader_(shader_modules) {}
+
+    void ComputePipeline::create(const std::span<const u32> code,
+                                 const ShaderReflection&    reflection,
+                                 PipelineLayoutCache&       layouts,
+                                 const vk::PipelineCache    cache,
+                                 const DeviceFeatures&      features,
+                                 const SpecializationData&  specialization) {
+        if (reflection.stage != vk::ShaderStageFlagBits::eCompute) {
+            log(ELogLvl::CRITICAL, "Compute pipelines can only be built from compute shaders");
+        }
+
+        shader_.create(code);
+
+        const std::array stages = {&reflection};
+        const auto&      layout = layouts.get(stages);
+
+        cached_layout_ = &layout;
+        layout_        = layout.pipeline_layout;
+        local_size_    = reflection.local_size;
+
+        const auto specialization_info = specialization.info();
+        const bool descriptor_buffer   = features.supports_descriptor_buffer();
+
+        const auto stage_info = vk::PipelineShaderStageCreateInfo {
+            .stage               = vk::ShaderStageFlagBits::eCompute,
+            .module              = shader_.get_module(),
+            .pName               = DEFAULT_SHADER_ENTRY_NAME,
+            .pSpecializationInfo = (specialization.empty() ? nullptr : &specialization_info),
+        };
+
+        const auto pipeline_info = vk::ComputePipelineCreateInfo {
+            .flags  = (descriptor_buffer ? vk::PipelineCreateFlagBits::eDescriptorBufferEXT : vk::PipelineCreateFlags {}),
+            .stage  = stage_info,
+            .layout = layout_,
+        };
+
+        const auto [result, pipeline] = device_.createComputePipeline(cache, pipeline_info);
+        handle_result(result, "Failed to create compute pipeline", ELogLvl::CRITICAL);
+        pipeline_ = pipeline;
+
+        // set layouts made for descriptor buffers can't be written through templates, those sets are written in place
+        if (!descriptor_buffer) {
+            for (u32 set = 0; set < layout.set_bindings.size(); ++set) {
+                if (layout.set_bindings[set].empty()) {
+                    continue;
+                }
+
+                auto& descriptor_template = templates_.try_emplace(set, device_).first->second;
+                descriptor_template.create(layout, set, layouts.is_push_set(set), vk::PipelineBindPoint::eCompute);
+            }
+        }
+
+        log(ELogLvl::DEBUG,
+            "Created compute pipeline with a local size of {}x{}x{}",
+            local_size_[0],
+            local_size_[1],
+            local_size_[2]);
+    }
+
+    void ComputePipeline::destroy() {
+        for (auto& [set, descriptor_template] : templates_) {
+            descriptor_template.destroy();
+        }
+        templates_.clear();
+
+        // the layout belongs to the layout cache, the module to the shader module cache
+        device_.destroyPipeline(pipeline_);
+        pipeline_ = nullptr;
+
+        shader_.destroy();
+    }
+
+    void ComputePipeline::bind(const vk::CommandBuffer cmd) const {
+        cmd.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline_);
+    }
+
+    void ComputePipeline::bind_set(const vk::CommandBuffer cmd, const u32 set, const vk::DescriptorSet descriptor_set) const {
+        cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, layout_, set, descriptor_set, {});
+    }
+
+    void ComputePipeline::dispatch(const vk::CommandBuffer cmd, const u32 x, const u32 y, const u32 z) const {
+        cmd.dispatch(x, y, z);
+    }
+
+    void ComputePipeline::dispatch_invocations(const vk::CommandBuffer cmd, const u32 x, const u32 y, const u32 z) const {
+        const auto groups = group_count(x, y, z);
+
+        // an empty dispatch is valid, but there's no point in recording it
+        if (groups[0] == 0 || groups[1] == 0 || groups[2] == 0) {
+            return;
+        }
+
+        cmd.dispatch(groups[0], groups[1], groups[2]);
+    }
+
+    void ComputePipeline::dispatch_indirect(const vk::CommandBuffer cmd, const vk::Buffer buffer, const vk::DeviceSize offset) const {
+        cmd.dispatchIndirect(buffer, offset);
+    }
+
+    void ComputePipeline::barrier(const vk::CommandBuffer       cmd,
+                                  const vk::PipelineStageFlags2 dst_stages,
+                                  const vk::AccessFlags2        dst_access) {
+        // a global barrier is as cheap as a buffer barrier on every driver that matters, and covers images as well
+        const auto barrier = vk::MemoryBarrier2 {
+            .srcStageMask  = vk::PipelineStageFlagBits2::eComputeShader,
+            .srcAccessMask = vk::AccessFlagBits2::eShaderStorageWrite,
+            .dstStageMask  = dst_stages,
+            .dstAccessMask = dst_access,
+        };
+
+        cmd.pipelineBarrier2(vk::DependencyInfo().setMemoryBarriers(barrier));
+    }
+
+    auto ComputePipeline::storage_buffer(const vk::Buffer buffer, const vk::DeviceSize offset, const vk::DeviceSize range)
+        -> vk::DescriptorBufferInfo {
+        return {.buffer = buffer, .offset = offset, .range = range};
+    }
+
+    auto ComputePipeline::storage_image(const vk::ImageView view) -> vk::DescriptorImageInfo {
+        return {.imageView = view, .imageLayout = vk::ImageLayout::eGeneral};
+    }
+
+    auto ComputePipeline::group_count(const u32 x, const u32 y, const u32 z) const -> std::array<u32, 3> {
+        return {
+            (x + local_size_[0] - 1) / local_size_[0],
+            (y + local_size_[1] - 1) / local_size_[1],
+            (z + local_size_[2] - 1) / local_size_[2],
+        };
+    }
+
+    auto ComputePipeline::local_size() const -> const std::array<u32, 3>& {
+        return local_size_;
+    }
+
+    auto ComputePipeline::get_handle() const -> vk::Pipeline {
+        return pipeline_;
+    }
+
+    auto ComputePipeline::get_layout() const -> vk::PipelineLayout {
+        return layout_;
+    }
+
+    auto ComputePipeline::cached_layout() const -> const PipelineLayoutCache::Layout& {
+        return *cached_layout_;
+    }
+
+    auto ComputePipeline::find_template(const u32 set) const -> const DescriptorTemplate* {
+        const auto descriptor_template = templates_.find(set);
+        if (descriptor_template == templates_.end()) {
+            log(ELogLvl::ERROR, "Compute pipeline has no update template for set {}", set);
+            return nullptr;
+        }
+
+        return &descriptor_template->second;
+    }
+}  // namespace sylk
@@ -0,0 +1,242 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/pipeline/pipeline_cache.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    constexpr sylk::u32 CACHE_FILE_MAGIC   = 0x43505953;  // "SYPC"
+    constexpr sylk::u32 CACHE_FILE_VERSION = 1;
+
+    // layout of VkPipelineCacheHeaderVersionOne, which every driver places at the start of its cache data
+    constexpr sylk::u64 DRIVER_HEADER_SIZE = 16 + VK_UUID_SIZE;
+
+    // %LOCALAPPDATA% on windows, $XDG_CACHE_HOME or ~/.cache elsewhere, empty if none of them are set
+    auto user_cache_directory() -> std::filesystem::path {
+#ifdef _WIN32
+        if (const char* local_app_data = std::getenv("LOCALAPPDATA")) {
+            return local_app_data;
+        }
+#else
+        if (const char* xdg_cache = std::getenv("XDG_CACHE_HOME"); xdg_cache && *xdg_cache) {
+            return xdg_cache;
+        }
+        if (const char* home = std::getenv("HOME"); home && *home) {
+            return std::filesystem::path(home) / ".cache";
+        }
+#endif
+        return {};
+    }
+}  // namespace
+
+namespace sylk {
+    PipelineCache::PipelineCache(const vk::Device& device)
+        : device_(device)
+        , expected_header_()
+        , warm_(false)
+        , last_saved_size_(0)
+        , saving_(false) {}
+
+    void PipelineCache::create(const vk::PhysicalDevice physical_device, std::filesystem::path path) {
+        // relative paths would otherwise follow the working directory, which changes with how the app is started
+        if (const auto cache_directory = user_cache_directory(); path.is_relative() && !cache_directory.empty()) {
+            path = cache_directory / path;
+        }
+        path_ = std::move(path);
+
+        if (path_.has_parent_path()) {
+            std::error_code error;
+            std::filesystem::create_directories(path_.parent_path(), error);
+            if (error) {
+                log(ELogLvl::WARN, "Failed to create pipeline cache directory {}: {}", path_.parent_path().string(), error.message());
+            }
+        }
+
+        const auto properties  = physical_device.getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceIDProperties>();
+        const auto& core_props = properties.get<vk::PhysicalDeviceProperties2>().properties;
+        const auto& id_props   = properties.get<vk::PhysicalDeviceIDProperties>();
+
+        expected_header_ = FileHeader {
+            .magic          = CACHE_FILE_MAGIC,
+            .version        = CACHE_FILE_VERSION,
+            .vendor_id      = core_props.vendorID,
+            .device_id      = core_props.deviceID,
+            .driver_version = core_props.driverVersion,
+            .reserved       = 0,
+        };
+        std::copy(id_props.deviceUUID.begin(), id_props.deviceUUID.end(), expected_header_.device_uuid.begin());
+        std::copy(core_props.pipelineCacheUUID.begin(), core_props.pipelineCacheUUID.end(), expected_header_.cache_uuid.begin());
+
+        const auto initial_data = load();
+
+        const auto cache_info = vk::PipelineCacheCreateInfo {
+            .initialDataSize = initial_data.size(),
+            .pInitialData    = initial_data.data(),
+        };
+
+        const auto [result, cache] = device_.createPipelineCache(cache_info);
+        handle_result(result, "Failed to create pipeline cache");
+        cache_ = cache;
+
+        warm_            = !initial_data.empty();
+        last_saved_size_ = initial_data.size();
+        last_save_time_  = std::chrono::steady_clock::now();
+
+        log(ELogLvl::DEBUG, "Created {} pipeline cache ({} bytes loaded)", (warm_ ? "warm" : "cold"), initial_data.size());
+    }
+
+    void PipelineCache::destroy() {
+        save();
+
+        device_.destroyPipelineCache(cache_);
+        log(ELogLvl::TRACE, "Destroyed pipeline cache");
+    }
+
+    void PipelineCache::save() {
+        const auto [result, data] = device_.getPipelineCacheData(cache_);
+        handle_result(result, "Failed to retrieve pipeline cache data");
+
+        if (result != vk::Result::eSuccess || data.empty()) {
+            return;
+        }
+
+        auto header      = expected_header_;
+        header.data_size = data.size();
+        header.data_hash = fnv1a(data.data(), data.size());
+
+        // write everything to a temporary file first and swap it in afterwards,
+        // so a crash halfway through a save can never leave a truncated cache behind
+        auto temp_path = path_;
+        temp_path += ".tmp";
+
+        {
+            std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(data.data()), cast<std::streamsize>(data.size()));
+
+            // closing flushes what's still buffered, which can fail just as well as the writes themselves
+            file.close();
+            if (!file.good()) {
+                log(ELogLvl::WARN, "Failed to write pipeline cache to {}", temp_path.string());
+                return;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temp_path, path_, error);
+        if (error) {
+            log(ELogLvl::WARN, "Failed to replace pipeline cache file {}: {}", path_.string(), error.message());
+            return;
+        }
+
+        last_saved_size_ = data.size();
+
+        log(ELogLvl::DEBUG, "Saved {} bytes of pipeline cache data to {}", data.size(), path_.string());
+    }
+
+    void PipelineCache::save_if_changed() {
+        // the cache only ever grows, so an unchanged size means nothing new was compiled
+        size_t current_size = 0;
+        handle_result(device_.getPipelineCacheData(cache_, &current_size, nullptr), "Failed to query pipeline cache size");
+
+        if (current_size != last_saved_size_) {
+            save();
+        }
+
+        saving_.store(false, std::memory_order_release);
+    }
+
+    auto PipelineCache::save_due(const std::chrono::seconds interval) -> bool {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_save_time_ < interval || saving_.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        last_save_time_ = now;
+        saving_.store(true, std::memory_order_release);
+
+        return true;
+    }
+
+    auto PipelineCache::was_warm() const -> bool {
+        return warm_;
+    }
+
+    auto PipelineCache::get_handle() const -> vk::PipelineCache {
+        return cache_;
+    }
+
+    auto PipelineCache::load() const -> std::vector<u8> {
+        std::ifstream file(path_, std::ios::ate | std::ios::binary);
+
+        if (!file.is_open()) {
+            log(ELogLvl::DEBUG, "No pipeline cache found at {}", path_.string());
+            return {};
+        }
+
+        const auto file_size = cast<u64>(file.tellg());
+        if (file_size < sizeof(FileHeader)) {
+            log(ELogLvl::WARN, "Discarding truncated pipeline cache file {}", path_.string());
+            return {};
+        }
+
+        FileHeader header;
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        if (!matches_device(header)) {
+            log(ELogLvl::INFO, "Discarding pipeline cache written by a different device or driver");
+            return {};
+        }
+
+        if (header.data_size != file_size - sizeof(FileHeader)) {
+            log(ELogLvl::WARN, "Discarding pipeline cache with a mismatched size");
+            return {};
+        }
+
+        std::vector<u8> data(header.data_size);
+        file.read(reinterpret_cast<char*>(data.data()), cast<std::streamsize>(data.size()));
+
+        if (!file.good() || fnv1a(data.data(), data.size()) != header.data_hash) {
+            log(ELogLvl::WARN, "Discarding corrupted pipeline cache file {}", path_.string());
+            return {};
+        }
+
+        if (!matches_driver_header(data)) {
+            log(ELogLvl::WARN, "Discarding pipeline cache with an incompatible driver header");
+            return {};
+        }
+
+        return data;
+    }
+
+    auto PipelineCache::matches_device(const FileHeader& header) const -> bool {
+        return header.magic == expected_header_.magic && header.version == expected_header_.version &&
+               header.vendor_id == expected_header_.vendor_id && header.device_id == expected_header_.device_id &&
+               header.driver_version == expected_header_.driver_version && header.device_uuid == expected_header_.device_uuid &&
+               header.cache_uuid == expected_header_.cache_uuid;
+    }
+
+    auto PipelineCache::matches_driver_header(const std::vector<u8>& data) const -> bool {
+        if (data.size() < DRIVER_HEADER_SIZE) {
+            return false;
+        }
+
+        u32 header_fields[4];
+        std::memcpy(header_fields, data.data(), sizeof(header_fields));
+
+        const auto [header_size, header_version, vendor_id, device_id] = header_fields;
+
+        return header_size >= DRIVER_HEADER_SIZE && header_size <= data.size() &&
+               header_version == cast<u32>(vk::PipelineCacheHeaderVersion::eOne) && vendor_id == expected_header_.vendor_id &&
+               device_id == expected_header_.device_id &&
+               std::memcmp(data.data() + 16, expected_header_.cache_uuid.data(), VK_UUID_SIZE) == 0;
+    }
+}  // namespace sylk
@@ -0,0 +1,103 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/pipeline/pipeline_desc.hpp>
+
+namespace {
+    // every part is built against the same layout and renderpass, so all of them hash those
+    auto hash_shared_state(const sylk::PipelineDesc& desc) -> sylk::u64 {
+        using namespace sylk;
+
+        u64 seed = FNV_OFFSET_BASIS;
+        seed     = hash_combine(seed, hash_value(static_cast<VkPipelineLayout>(desc.layout)));
+        seed     = hash_combine(seed, hash_value(static_cast<VkRenderPass>(desc.renderpass)));
+        seed     = hash_combine(seed, desc.subpass);
+
+        return seed;
+    }
+}  // namespace
+
+namespace sylk {
+    auto blend_enabled(const EBlendMode mode) -> bool {
+        return mode != EBlendMode::NONE;
+    }
+
+    auto blend_equation(const EBlendMode mode) -> vk::ColorBlendEquationEXT {
+        return {
+            .srcColorBlendFactor = vk::BlendFactor::eSrcAlpha,
+            .dstColorBlendFactor = (mode == EBlendMode::ADDITIVE ? vk::BlendFactor::eOne : vk::BlendFactor::eOneMinusSrcAlpha),
+            .colorBlendOp        = vk::BlendOp::eAdd,
+            .srcAlphaBlendFactor = vk::BlendFactor::eOne,
+            .dstAlphaBlendFactor = vk::BlendFactor::eZero,
+            .alphaBlendOp        = vk::BlendOp::eAdd,
+        };
+    }
+
+    auto PipelineDesc::hash() const -> u64 {
+        u64 seed = FNV_OFFSET_BASIS;
+
+        seed = hash_combine(seed, vertex_input_hash());
+        seed = hash_combine(seed, pre_rasterization_hash());
+        seed = hash_combine(seed, fragment_shader_hash());
+        seed = hash_combine(seed, fragment_output_hash());
+
+        // zero is reserved for empty handles
+        return (seed == 0 ? 1 : seed);
+    }
+
+    auto PipelineDesc::vertex_input_hash() const -> u64 {
+        // fields are hashed one by one, hashing the struct's bytes would pick up padding and vector internals
+        u64 seed = FNV_OFFSET_BASIS;
+
+        for (const auto& binding : vertex_bindings) {
+            seed = hash_combine(seed, binding.binding);
+            seed = hash_combine(seed, binding.stride);
+            seed = hash_combine(seed, cast<u64>(binding.inputRate));
+        }
+
+        for (const auto& attribute : vertex_attributes) {
+            seed = hash_combine(seed, attribute.location);
+            seed = hash_combine(seed, attribute.binding);
+            seed = hash_combine(seed, cast<u64>(attribute.format));
+            seed = hash_combine(seed, attribute.offset);
+        }
+
+        seed = hash_combine(seed, cast<u64>(state.topology));
+
+        return seed;
+    }
+
+    auto PipelineDesc::pre_rasterization_hash() const -> u64 {
+        u64 seed = hash_shared_state(*this);
+
+        seed = hash_combine(seed, hash_value(static_cast<VkShaderModule>(vertex_shader)));
+        seed = hash_combine(seed, vertex_specialization.hash());
+        seed = hash_combine(seed, cast<u64>(polygon_mode));
+        seed = hash_combine(seed, cast<u64>(static_cast<VkCullModeFlags>(state.cull_mode)));
+        seed = hash_combine(seed, cast<u64>(state.front_face));
+
+        return seed;
+    }
+
+    auto PipelineDesc::fragment_shader_hash() const -> u64 {
+        u64 seed = hash_shared_state(*this);
+
+        seed = hash_combine(seed, hash_value(static_cast<VkShaderModule>(fragment_shader)));
+        seed = hash_combine(seed, fragment_specialization.hash());
+        seed = hash_combine(seed, cast<u64>(state.depth_test));
+        seed = hash_combine(seed, cast<u64>(state.depth_write));
+        seed = hash_combine(seed, cast<u64>(state.depth_compare));
+
+        return seed;
+    }
+
+    auto PipelineDesc::fragment_output_hash() const -> u64 {
+        u64 seed = hash_shared_state(*this);
+
+        seed = hash_combine(seed, cast<u64>(state.blend));
+
+        return seed;
+    }
+}  // namespace sylk
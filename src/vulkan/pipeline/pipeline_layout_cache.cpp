@@ -0,0 +1,215 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/pipeline/pipeline_layout_cache.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+#include <algorithm>
+
+namespace sylk {
+    PipelineLayoutCache::PipelineLayoutCache(const vk::Device& device)
+        : device_(device) {}
+
+    void PipelineLayoutCache::create(const vk::PhysicalDevice physical_device, const vk::DescriptorSetLayoutCreateFlags set_layout_flags) {
+        max_push_constants_size_ = physical_device.getProperties().limits.maxPushConstantsSize;
+        set_layout_flags_        = set_layout_flags;
+        log(ELogLvl::TRACE, "Push constants are limited to {} bytes", max_push_constants_size_);
+    }
+
+    void PipelineLayoutCache::destroy() {
+        for (const auto& [key, layout] : layouts_) {
+            device_.destroyPipelineLayout(layout->pipeline_layout);
+        }
+
+        for (const auto& [key, set_layout] : set_layouts_) {
+            device_.destroyDescriptorSetLayout(set_layout);
+        }
+
+        log(ELogLvl::TRACE, "Destroyed {} pipeline layout(s) and {} descriptor set layout(s)", layouts_.size(), set_layouts_.size());
+
+        layouts_.clear();
+        set_layouts_.clear();
+        reserved_sets_.clear();
+        push_sets_.clear();
+    }
+
+    void PipelineLayoutCache::reserve_set(const u32 set, const vk::DescriptorSetLayout set_layout) {
+        if (!layouts_.empty()) {
+            log(ELogLvl::ERROR, "Set {} was reserved after layouts were created, those layouts won't include it", set);
+        }
+
+        // reserved layouts are owned by whoever reserved them, so they never end up in set_layouts_
+        reserved_sets_[set] = set_layout;
+    }
+
+    void PipelineLayoutCache::push_set(const u32 set) {
+        if (!layouts_.empty()) {
+            log(ELogLvl::ERROR, "Set {} was made a push set after layouts were created, those layouts still allocate it", set);
+        }
+
+        push_sets_.insert(set);
+    }
+
+    auto PipelineLayoutCache::get(const std::span<const ShaderReflection* const> stages) -> const Layout& {
+        // (set, binding) -> binding, with the stage flags of every stage that uses it
+        std::map<std::pair<u32, u32>, ReflectedBinding> merged_bindings;
+        std::vector<PushConstantKey>                    push_constants;
+
+        for (const auto* stage : stages) {
+            for (const auto& binding : stage->bindings) {
+                if (reserved_sets_.contains(binding.set)) {
+                    continue;
+                }
+
+                const auto [it, inserted] = merged_bindings.try_emplace({binding.set, binding.binding}, binding);
+                if (inserted) {
+                    continue;
+                }
+
+                if (it->second.type != binding.type || it->second.count != binding.count) {
+                    log(ELogLvl::CRITICAL, "Stages disagree on the descriptor at set {} binding {}", binding.set, binding.binding);
+                }
+
+                it->second.stages |= binding.stages;
+            }
+
+            for (const auto& range : stage->push_constants) {
+                if (range.offset + range.size > max_push_constants_size_) {
+                    log(ELogLvl::CRITICAL,
+                        "Push constants end at byte {}, the device supports {}",
+                        range.offset + range.size,
+                        max_push_constants_size_);
+                }
+
+                push_constants.emplace_back(range.offset, range.size, static_cast<VkShaderStageFlags>(range.stages));
+            }
+        }
+
+        std::vector<std::vector<BindingKey>> set_bindings;
+        for (const auto& [location, binding] : merged_bindings) {
+            if (set_bindings.size() <= binding.set) {
+                set_bindings.resize(binding.set + 1);
+            }
+
+            set_bindings[binding.set].emplace_back(binding.binding,
+                                                   binding.type,
+                                                   binding.count,
+                                                   static_cast<VkShaderStageFlags>(binding.stages));
+        }
+
+        if (!reserved_sets_.empty() && set_bindings.size() <= reserved_sets_.rbegin()->first) {
+            set_bindings.resize(reserved_sets_.rbegin()->first + 1);
+        }
+
+        std::vector<vk::DescriptorSetLayout> set_layouts;
+        std::vector<VkDescriptorSetLayout>   set_layout_handles;
+        for (u32 set = 0; set < set_bindings.size(); ++set) {
+            const auto reserved = reserved_sets_.find(set);
+            if (reserved != reserved_sets_.end()) {
+                set_layouts.push_back(reserved->second);
+            } else {
+                const auto flags = (push_sets_.contains(set) ? set_layout_flags_ | vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR
+                                                             : set_layout_flags_);
+                set_layouts.push_back(get_set_layout(set_bindings[set], flags));
+            }
+
+            set_layout_handles.push_back(set_layouts.back());
+        }
+
+        std::ranges::sort(push_constants);
+
+        auto& layout = layouts_[LayoutKey {set_layout_handles, push_constants}];
+        if (layout) {
+            return *layout;
+        }
+
+        std::vector<vk::PushConstantRange> ranges;
+        for (const auto& [offset, size, stage_flags] : push_constants) {
+            ranges.push_back({
+                .stageFlags = vk::ShaderStageFlags(stage_flags),
+                .offset     = offset,
+                .size       = size,
+            });
+        }
+
+        const auto layout_info = vk::PipelineLayoutCreateInfo().setSetLayouts(set_layouts).setPushConstantRanges(ranges);
+
+        const auto [result, pipeline_layout] = device_.createPipelineLayout(layout_info);
+        handle_result(result, "Failed to create pipeline layout", ELogLvl::ERROR);
+
+        std::vector<std::vector<vk::DescriptorSetLayoutBinding>> layout_bindings;
+        for (const auto& bindings : set_bindings) {
+            layout_bindings.push_back(to_layout_bindings(bindings));
+        }
+
+        layout = std::make_unique<Layout>(Layout {
+            .pipeline_layout      = pipeline_layout,
+            .set_layouts          = std::move(set_layouts),
+            .push_constant_ranges = std::move(ranges),
+            .set_bindings         = std::move(layout_bindings),
+        });
+
+        log(ELogLvl::TRACE,
+            "Created pipeline layout with {} set(s) and {} push constant range(s)",
+            layout->set_layouts.size(),
+            layout->push_constant_ranges.size());
+
+        return *layout;
+    }
+
+    auto PipelineLayoutCache::get_set_layout(const std::vector<BindingKey>& bindings, const vk::DescriptorSetLayoutCreateFlags flags)
+        -> vk::DescriptorSetLayout {
+        const auto key = SetLayoutKey {static_cast<VkDescriptorSetLayoutCreateFlags>(flags), bindings};
+        if (const auto it = set_layouts_.find(key); it != set_layouts_.end()) {
+            return it->second;
+        }
+
+        const auto layout_bindings = to_layout_bindings(bindings);
+        const auto layout_info = vk::DescriptorSetLayoutCreateInfo {.flags = flags}.setBindings(layout_bindings);
+
+        const auto [result, set_layout] = device_.createDescriptorSetLayout(layout_info);
+        handle_result(result, "Failed to create descriptor set layout", ELogLvl::ERROR);
+
+        set_layouts_.emplace(key, set_layout);
+
+        return set_layout;
+    }
+
+    auto PipelineLayoutCache::to_layout_bindings(const std::vector<BindingKey>& bindings) -> std::vector<vk::DescriptorSetLayoutBinding> {
+        std::vector<vk::DescriptorSetLayoutBinding> layout_bindings;
+        for (const auto& [binding, type, count, stage_flags] : bindings) {
+            layout_bindings.push_back({
+                .binding         = binding,
+                .descriptorType  = type,
+                .descriptorCount = count,
+                .stageFlags      = vk::ShaderStageFlags(stage_flags),
+            });
+        }
+
+        return layout_bindings;
+    }
+
+    auto PipelineLayoutCache::find(const vk::PipelineLayout pipeline_layout) const -> const Layout* {
+        for (const auto& [key, layout] : layouts_) {
+            if (layout->pipeline_layout == pipeline_layout) {
+                return layout.get();
+            }
+        }
+
+        return nullptr;
+    }
+
+    auto PipelineLayoutCache::is_push_set(const u32 set) const -> bool {
+        return push_sets_.contains(set);
+    }
+
+    auto PipelineLayoutCache::layout_count() const -> u64 {
+        return layouts_.size();
+    }
+
+    auto PipelineLayoutCache::set_layout_count() const -> u64 {
+        return set_layouts_.size();
+    }
+}  // namespace sylk
@@ -0,0 +1,722 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/pipeline/pipeline_cache.hpp>
+#include <sylk/vulkan/pipeline/pipeline_library.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+#include <array>
+#include <chrono>
+
+constexpr const char* DEFAULT_SHADER_ENTRY_NAME = "main";
+
+namespace {
+    auto blend_attachment_state(const sylk::EBlendMode mode) -> vk::PipelineColorBlendAttachmentState {
+        const auto equation = sylk::blend_equation(mode);
+
+        return {
+            .blendEnable         = sylk::blend_enabled(mode),
+            .srcColorBlendFactor = equation.srcColorBlendFactor,
+            .dstColorBlendFactor = equation.dstColorBlendFactor,
+            .colorBlendOp        = equation.colorBlendOp,
+            .srcAlphaBlendFactor = equation.srcAlphaBlendFactor,
+            .dstAlphaBlendFactor = equation.dstAlphaBlendFactor,
+            .alphaBlendOp        = equation.alphaBlendOp,
+            .colorWriteMask      = vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB |
+                                   vk::ColorComponentFlagBits::eA,
+        };
+    }
+
+    // a dynamic topology has to stay within the class of the one the pipeline was built with
+    auto topology_class(const vk::PrimitiveTopology topology) -> vk::PrimitiveTopology {
+        switch (topology) {
+        case vk::PrimitiveTopology::ePointList:
+            return vk::PrimitiveTopology::ePointList;
+        case vk::PrimitiveTopology::eLineList:
+        case vk::PrimitiveTopology::eLineStrip:
+        case vk::PrimitiveTopology::eLineListWithAdjacency:
+        case vk::PrimitiveTopology::eLineStripWithAdjacency:
+            return vk::PrimitiveTopology::eLineList;
+        case vk::PrimitiveTopology::ePatchList:
+            return vk::PrimitiveTopology::ePatchList;
+        default:
+            return vk::PrimitiveTopology::eTriangleList;
+        }
+    }
+
+    // every fixed-function state block a description expands into
+    // the create infos point into each other, so this has to stay where it was constructed
+    struct PipelineStates {
+        PipelineStates(const sylk::PipelineDesc& desc, const bool dynamic_blend)
+            : shader_stages {
+                vk::PipelineShaderStageCreateInfo {
+                    .stage  = vk::ShaderStageFlagBits::eVertex,
+                    .module = desc.vertex_shader,
+                    .pName  = DEFAULT_SHADER_ENTRY_NAME,
+                },
+                vk::PipelineShaderStageCreateInfo {
+                    .stage  = vk::ShaderStageFlagBits::eFragment,
+                    .module = desc.fragment_shader,
+                    .pName  = DEFAULT_SHADER_ENTRY_NAME,
+                },
+            }
+            , dynamic_states {
+                vk::DynamicState::eViewport,
+                vk::DynamicState::eScissor,
+                vk::DynamicState::ePrimitiveTopology,
+                vk::DynamicState::eCullMode,
+                vk::DynamicState::eFrontFace,
+                vk::DynamicState::eDepthTestEnable,
+                vk::DynamicState::eDepthWriteEnable,
+                vk::DynamicState::eDepthCompareOp,
+            }
+            , input_assembly {
+                .topology               = desc.state.topology,
+                .primitiveRestartEnable = false,
+            }
+            // viewport and scissor are dynamic, only their count matters here
+            , viewport {
+                .viewportCount = 1,
+                .scissorCount  = 1,
+            }
+            , rasterization {
+                .depthClampEnable        = false,
+                .rasterizerDiscardEnable = false,
+                .polygonMode             = desc.polygon_mode,
+                .cullMode                = desc.state.cull_mode,
+                .frontFace               = desc.state.front_face,
+                .depthBiasEnable         = false,
+                .lineWidth               = 1.0f,
+            }
+            , multisample {
+                .rasterizationSamples = vk::SampleCountFlagBits::e1,
+                .sampleShadingEnable  = false,
+            }
+            , depth_stencil {
+                .depthTestEnable  = desc.state.depth_test,
+                .depthWriteEnable = desc.state.depth_write,
+                .depthCompareOp   = desc.state.depth_compare,
+            }
+            , blend_attachment(blend_attachment_state(desc.state.blend)) {
+            if (!desc.vertex_specialization.empty()) {
+                vertex_specialization                = desc.vertex_specialization.info();
+                shader_stages[0].pSpecializationInfo = &vertex_specialization;
+            }
+
+            if (!desc.fragment_specialization.empty()) {
+                fragment_specialization              = desc.fragment_specialization.info();
+                shader_stages[1].pSpecializationInfo = &fragment_specialization;
+            }
+
+            if (dynamic_blend) {
+                dynamic_states.push_back(vk::DynamicState::eColorBlendEnableEXT);
+                dynamic_states.push_back(vk::DynamicState::eColorBlendEquationEXT);
+            }
+
+            dynamic_state = vk::PipelineDynamicStateCreateInfo().setDynamicStates(dynamic_states);
+            vertex_input  = vk::PipelineVertexInputStateCreateInfo()
+                               .setVertexAttributeDescriptions(desc.vertex_attributes)
+                               .setVertexBindingDescriptions(desc.vertex_bindings);
+            color_blend = vk::PipelineColorBlendStateCreateInfo {.logicOpEnable = false}.setAttachments(blend_attachment);
+        }
+
+        PipelineStates(const PipelineStates&)                    = delete;
+        auto operator=(const PipelineStates&) -> PipelineStates& = delete;
+
+        std::array<vk::PipelineShaderStageCreateInfo, 2> shader_stages;
+        vk::SpecializationInfo                           vertex_specialization;
+        vk::SpecializationInfo                           fragment_specialization;
+        std::vector<vk::DynamicState>                    dynamic_states;
+
+        vk::PipelineInputAssemblyStateCreateInfo  input_assembly;
+        vk::PipelineViewportStateCreateInfo       viewport;
+        vk::PipelineRasterizationStateCreateInfo  rasterization;
+        vk::PipelineMultisampleStateCreateInfo    multisample;
+        vk::PipelineDepthStencilStateCreateInfo   depth_stencil;
+        vk::PipelineColorBlendAttachmentState     blend_attachment;
+        vk::PipelineDynamicStateCreateInfo        dynamic_state;
+        vk::PipelineVertexInputStateCreateInfo    vertex_input;
+        vk::PipelineColorBlendStateCreateInfo     color_blend;
+    };
+
+    auto elapsed_ms(const std::chrono::steady_clock::time_point start) -> sylk::f64 {
+        return std::chrono::duration<sylk::f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}  // namespace
+
+namespace sylk {
+    PipelineLibrary::PipelineLibrary(const vk::Device& device)
+        : device_(device) {}
+
+    void PipelineLibrary::create(const vk::PipelineCache cache,
+                                 const u32               worker_count,
+                                 const u32               frames_in_flight,
+                                 const DeviceFeatures&   features) {
+        cache_              = cache;
+        frames_in_flight_   = frames_in_flight;
+        use_part_libraries_ = features.supports_pipeline_library();
+        dynamic_blend_      = features.supports_dynamic_blend();
+        base_flags_         = (features.supports_descriptor_buffer() ? vk::PipelineCreateFlagBits::eDescriptorBufferEXT
+                                                                     : vk::PipelineCreateFlags {});
+
+        for (u32 i = 0; i < worker_count; ++i) {
+            workers_.emplace_back([this](const std::stop_token& stop_token) { work(stop_token); });
+        }
+
+        log(ELogLvl::TRACE,
+            "Started {} pipeline compile worker(s), {}",
+            worker_count,
+            (use_part_libraries_ ? "linking from pipeline library parts" : "compiling monolithic pipelines"));
+    }
+
+    void PipelineLibrary::destroy() {
+        // jthreads request a stop and join on destruction, which also wakes any worker waiting for work
+        workers_.clear();
+
+        for (auto& [key, entry] : entries_) {
+            if (const auto pipeline = entry->pipeline.load()) {
+                device_.destroyPipeline(pipeline);
+            }
+        }
+
+        for (const auto& retired : retired_) {
+            device_.destroyPipeline(retired.pipeline);
+        }
+
+        for (const auto& reloaded : reloaded_) {
+            device_.destroyPipeline(reloaded.pipeline);
+        }
+
+        // parts may only go once nothing linked from them is left
+        for (const auto& [key, part] : parts_) {
+            device_.destroyPipeline(part);
+        }
+
+        log(ELogLvl::TRACE, "Destroyed {} graphics pipeline(s) and {} pipeline part(s)", entries_.size(), parts_.size());
+
+        entries_.clear();
+        parts_.clear();
+        retired_.clear();
+        reloaded_.clear();
+        replacements_.clear();
+        queue_.clear();
+    }
+
+    auto PipelineLibrary::request(const PipelineDesc& desc) -> PipelineHandle {
+        bool   inserted = false;
+        u64    key;
+        Entry* entry;
+
+        {
+            std::scoped_lock lock(mutex_);
+            std::tie(key, entry) = find_or_insert(normalize(desc), inserted);
+        }
+
+        if (inserted) {
+            push_job({.entry = entry});
+        }
+
+        return {key};
+    }
+
+    auto PipelineLibrary::request_blocking(const PipelineDesc& desc) -> PipelineHandle {
+        bool   inserted = false;
+        u64    key;
+        Entry* entry;
+
+        {
+            std::scoped_lock lock(mutex_);
+            std::tie(key, entry) = find_or_insert(normalize(desc), inserted);
+        }
+
+        // whoever moves the entry out of the queued state gets to compile it, a worker that pops it later skips it
+        auto expected = EState::QUEUED;
+        if (entry->state.compare_exchange_strong(expected, EState::COMPILING)) {
+            compile_entry(*entry);
+            return {key};
+        }
+
+        auto current = entry->state.load(std::memory_order_acquire);
+        while (current == EState::QUEUED || current == EState::COMPILING) {
+            entry->state.wait(current);
+            current = entry->state.load(std::memory_order_acquire);
+        }
+
+        return {key};
+    }
+
+    auto PipelineLibrary::replace_module(const vk::ShaderModule from, const vk::ShaderModule to) -> u32 {
+        std::vector<Job> jobs;
+
+        {
+            std::scoped_lock lock(mutex_);
+
+            for (const auto& [key, entry] : entries_) {
+                // queued entries haven't been compiled yet, they pick the replacement up when they are
+                if (entry->state.load(std::memory_order_acquire) == EState::QUEUED) {
+                    continue;
+                }
+
+                if (replaced(entry->desc.vertex_shader) != from && replaced(entry->desc.fragment_shader) != from) {
+                    continue;
+                }
+
+                jobs.push_back({.entry = entry.get(), .reload = true, .ticket = ++entry->reload_ticket});
+            }
+
+            // kept flat, so a module handed back again by the module cache can't close a loop in a chain of replacements
+            for (auto& [original, latest] : replacements_) {
+                if (latest == from) {
+                    latest = to;
+                }
+            }
+            replacements_.erase(to);
+            if (from != to) {
+                replacements_[from] = to;
+            }
+        }
+
+        for (const auto& job : jobs) {
+            push_job(job);
+        }
+
+        return cast<u32>(jobs.size());
+    }
+
+    void PipelineLibrary::begin_frame() {
+        std::scoped_lock lock(mutex_);
+        ++frame_;
+
+        // the fence wait before this covers every frame up to frames_in_flight_ ago, nothing older can still be in use
+        std::erase_if(retired_, [&](const Retired& retired) {
+            if (retired.frame + frames_in_flight_ > frame_) {
+                return false;
+            }
+
+            device_.destroyPipeline(retired.pipeline);
+            return true;
+        });
+    }
+
+    void PipelineLibrary::save_cache(PipelineCache& cache) {
+        push_job({.cache = &cache});
+    }
+
+    auto PipelineLibrary::swap_reloaded() -> u32 {
+        std::vector<Job> optimize_jobs;
+        u32              swapped = 0;
+
+        {
+            std::scoped_lock lock(mutex_);
+
+            std::erase_if(reloaded_, [&](const Reloaded& reloaded) {
+                auto& entry = *reloaded.entry;
+
+                // the original compile has to land first, or it would overwrite the reloaded pipeline
+                const auto state = entry.state.load(std::memory_order_acquire);
+                if (state == EState::QUEUED || state == EState::COMPILING) {
+                    return false;
+                }
+
+                // a later reload of the same entry is on its way, this one was never bound so it can go right away
+                if (reloaded.ticket != entry.reload_ticket) {
+                    device_.destroyPipeline(reloaded.pipeline);
+                    return true;
+                }
+
+                // command buffers still in flight may reference the previous pipeline, so it's kept around until they're done
+                if (const auto previous = entry.pipeline.exchange(reloaded.pipeline, std::memory_order_acq_rel)) {
+                    retired_.push_back({.pipeline = previous, .frame = frame_});
+                }
+
+                ++entry.generation;
+                entry.state.store(EState::READY, std::memory_order_release);
+                entry.state.notify_all();
+
+                if (use_part_libraries_) {
+                    optimize_jobs.push_back({.entry = &entry, .optimize = true});
+                }
+
+                ++swapped;
+                return true;
+            });
+        }
+
+        for (const auto& job : optimize_jobs) {
+            push_job(job);
+        }
+
+        return swapped;
+    }
+
+    auto PipelineLibrary::resolve(const PipelineHandle handle, const PipelineHandle fallback) const -> vk::Pipeline {
+        for (const auto candidate : {handle, fallback}) {
+            const auto* entry = find(candidate);
+
+            if (entry && entry->state.load(std::memory_order_acquire) == EState::READY) {
+                return entry->pipeline.load(std::memory_order_acquire);
+            }
+        }
+
+        return nullptr;
+    }
+
+    auto PipelineLibrary::state(const PipelineHandle handle) const -> EState {
+        const auto* entry = find(handle);
+        return (entry ? entry->state.load(std::memory_order_acquire) : EState::FAILED);
+    }
+
+    auto PipelineLibrary::pending_count() const -> u64 {
+        std::scoped_lock lock(mutex_);
+
+        u64 pending = 0;
+        for (const auto& [key, entry] : entries_) {
+            const auto current = entry->state.load(std::memory_order_relaxed);
+            pending += (current == EState::QUEUED || current == EState::COMPILING);
+        }
+
+        return pending;
+    }
+
+    auto PipelineLibrary::dynamic_blend() const -> bool {
+        return dynamic_blend_;
+    }
+
+    auto PipelineLibrary::normalize(const PipelineDesc& desc) const -> PipelineDesc {
+        // dynamic state is overwritten at record time, so descriptions that only differ there share one pipeline
+        auto normalized = desc;
+
+        normalized.state.topology      = topology_class(desc.state.topology);
+        normalized.state.cull_mode     = vk::CullModeFlagBits::eNone;
+        normalized.state.front_face    = vk::FrontFace::eCounterClockwise;
+        normalized.state.depth_test    = false;
+        normalized.state.depth_write   = false;
+        normalized.state.depth_compare = vk::CompareOp::eLess;
+
+        if (dynamic_blend_) {
+            normalized.state.blend = EBlendMode::NONE;
+        }
+
+        return normalized;
+    }
+
+    auto PipelineLibrary::current_desc(const Entry& entry) const -> std::pair<PipelineDesc, u32> {
+        std::scoped_lock lock(mutex_);
+
+        auto desc            = entry.desc;
+        desc.vertex_shader   = replaced(desc.vertex_shader);
+        desc.fragment_shader = replaced(desc.fragment_shader);
+
+        return {desc, entry.generation};
+    }
+
+    auto PipelineLibrary::replaced(const vk::ShaderModule module) const -> vk::ShaderModule {
+        // every replacement points straight at the latest module, replace_module() keeps it that way
+        const auto it = replacements_.find(module);
+
+        return (it != replacements_.end() ? it->second : module);
+    }
+
+    auto PipelineLibrary::find_or_insert(const PipelineDesc& desc, bool& inserted) -> std::pair<u64, Entry*> {
+        u64 key = desc.hash();
+
+        // a collision is astronomically unlikely, but probing keeps it from silently aliasing two different pipelines
+        for (auto it = entries_.find(key); it != entries_.end(); it = entries_.find(key)) {
+            if (it->second->desc == desc) {
+                inserted = false;
+                return {key, it->second.get()};
+            }
+
+            key = hash_combine(key, 1);
+        }
+
+        auto& entry = entries_[key];
+        entry       = std::make_unique<Entry>();
+        entry->desc = desc;
+        inserted    = true;
+
+        return {key, entry.get()};
+    }
+
+    auto PipelineLibrary::find(const PipelineHandle handle) const -> const Entry* {
+        if (!handle) {
+            return nullptr;
+        }
+
+        std::scoped_lock lock(mutex_);
+        const auto       it = entries_.find(handle.key);
+
+        return (it != entries_.end() ? it->second.get() : nullptr);
+    }
+
+    void PipelineLibrary::compile_entry(Entry& entry) {
+        const auto [desc, generation] = current_desc(entry);
+        const auto pipeline           = (use_part_libraries_ ? link(desc, false) : compile(desc));
+
+        entry.pipeline.store(pipeline, std::memory_order_release);
+        entry.state.store((pipeline ? EState::READY : EState::FAILED), std::memory_order_release);
+        entry.state.notify_all();
+
+        if (pipeline && use_part_libraries_) {
+            push_job({.entry = &entry, .optimize = true});
+        }
+    }
+
+    void PipelineLibrary::optimize_entry(Entry& entry) {
+        const auto [desc, generation] = current_desc(entry);
+
+        const auto optimized = link(desc, true);
+        if (!optimized) {
+            // the fast-linked pipeline works fine, it's just slower on the gpu
+            return;
+        }
+
+        std::scoped_lock lock(mutex_);
+
+        // a reload was swapped in meanwhile, this was optimized from the modules it replaced
+        if (entry.generation != generation) {
+            device_.destroyPipeline(optimized);
+            return;
+        }
+
+        // command buffers still in flight may reference the fast-linked pipeline, so it's kept around until they're done
+        const auto fast_linked = entry.pipeline.exchange(optimized, std::memory_order_acq_rel);
+        retired_.push_back({.pipeline = fast_linked, .frame = frame_});
+    }
+
+    void PipelineLibrary::reload_entry(Entry& entry, const u32 ticket) {
+        // the fast link is enough to see the change, only the parts of the replaced stage have to be compiled for it
+        const auto [desc, generation] = current_desc(entry);
+        const auto pipeline           = (use_part_libraries_ ? link(desc, false) : compile(desc));
+
+        if (!pipeline) {
+            log(ELogLvl::WARN, "Reloaded pipeline {:#018x} failed to build, keeping the previous one", entry.desc.hash());
+            return;
+        }
+
+        std::scoped_lock lock(mutex_);
+        reloaded_.push_back({.entry = &entry, .pipeline = pipeline, .ticket = ticket});
+    }
+
+    void PipelineLibrary::push_job(const Job job) {
+        {
+            std::scoped_lock lock(mutex_);
+            queue_.push_back(job);
+        }
+
+        queue_signal_.notify_one();
+    }
+
+    void PipelineLibrary::work(const std::stop_token& stop_token) {
+        while (!stop_token.stop_requested()) {
+            Job job;
+
+            {
+                std::unique_lock lock(mutex_);
+                if (!queue_signal_.wait(lock, stop_token, [this] { return !queue_.empty(); })) {
+                    return;
+                }
+
+                job = queue_.front();
+                queue_.pop_front();
+            }
+
+            if (job.cache) {
+                job.cache->save_if_changed();
+                continue;
+            }
+
+            if (job.optimize) {
+                optimize_entry(*job.entry);
+                continue;
+            }
+
+            if (job.reload) {
+                reload_entry(*job.entry, job.ticket);
+                continue;
+            }
+
+            auto expected = EState::QUEUED;
+            if (job.entry->state.compare_exchange_strong(expected, EState::COMPILING)) {
+                compile_entry(*job.entry);
+            }
+        }
+    }
+
+    auto PipelineLibrary::compile(const PipelineDesc& desc) const -> vk::Pipeline {
+        const auto compile_start = std::chrono::steady_clock::now();
+        const auto states        = PipelineStates(desc, dynamic_blend_);
+
+        const auto pipeline_info =
+            vk::GraphicsPipelineCreateInfo {
+                .flags               = base_flags_,
+                .pVertexInputState   = &states.vertex_input,
+                .pInputAssemblyState = &states.input_assembly,
+                .pViewportState      = &states.viewport,
+                .pRasterizationState = &states.rasterization,
+                .pMultisampleState   = &states.multisample,
+                .pDepthStencilState  = &states.depth_stencil,
+                .pColorBlendState    = &states.color_blend,
+                .pDynamicState       = &states.dynamic_state,
+                .layout              = desc.layout,
+                .renderPass          = desc.renderpass,
+                .subpass             = desc.subpass,
+            }
+                .setStages(states.shader_stages);
+
+        const auto [result, pipeline] = device_.createGraphicsPipeline(cache_, pipeline_info);
+        handle_result(result, "Failed to create graphics pipeline", ELogLvl::ERROR);
+
+        if (result != vk::Result::eSuccess) {
+            return nullptr;
+        }
+
+        log(ELogLvl::DEBUG, "Compiled graphics pipeline {:#018x} in {:.2f} ms", desc.hash(), elapsed_ms(compile_start));
+
+        return pipeline;
+    }
+
+    auto PipelineLibrary::compile_part(const EPart part, const PipelineDesc& desc) const -> vk::Pipeline {
+        const auto compile_start = std::chrono::steady_clock::now();
+        const auto states        = PipelineStates(desc, dynamic_blend_);
+
+        auto library_info = vk::GraphicsPipelineLibraryCreateInfoEXT {};
+
+        // retaining the link time optimization info is what allows the optimized link later on
+        auto pipeline_info = vk::GraphicsPipelineCreateInfo {
+            .pNext = &library_info,
+            .flags = base_flags_ | vk::PipelineCreateFlagBits::eLibraryKHR |
+                     vk::PipelineCreateFlagBits::eRetainLinkTimeOptimizationInfoEXT,
+            .pDynamicState = &states.dynamic_state,
+        };
+
+        switch (part) {
+        case EPart::VERTEX_INPUT:
+            library_info.flags                = vk::GraphicsPipelineLibraryFlagBitsEXT::eVertexInputInterface;
+            pipeline_info.pVertexInputState   = &states.vertex_input;
+            pipeline_info.pInputAssemblyState = &states.input_assembly;
+            break;
+        case EPart::PRE_RASTERIZATION:
+            library_info.flags                = vk::GraphicsPipelineLibraryFlagBitsEXT::ePreRasterizationShaders;
+            pipeline_info.stageCount          = 1;
+            pipeline_info.pStages             = &states.shader_stages[0];
+            pipeline_info.pViewportState      = &states.viewport;
+            pipeline_info.pRasterizationState = &states.rasterization;
+            pipeline_info.layout              = desc.layout;
+            pipeline_info.renderPass          = desc.renderpass;
+            pipeline_info.subpass             = desc.subpass;
+            break;
+        case EPart::FRAGMENT_SHADER:
+            library_info.flags               = vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentShader;
+            pipeline_info.stageCount         = 1;
+            pipeline_info.pStages            = &states.shader_stages[1];
+            pipeline_info.pMultisampleState  = &states.multisample;
+            pipeline_info.pDepthStencilState = &states.depth_stencil;
+            pipeline_info.layout             = desc.layout;
+            pipeline_info.renderPass         = desc.renderpass;
+            pipeline_info.subpass            = desc.subpass;
+            break;
+        case EPart::FRAGMENT_OUTPUT:
+            library_info.flags              = vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentOutputInterface;
+            pipeline_info.pMultisampleState = &states.multisample;
+            pipeline_info.pColorBlendState  = &states.color_blend;
+            pipeline_info.renderPass        = desc.renderpass;
+            pipeline_info.subpass           = desc.subpass;
+            break;
+        }
+
+        const auto [result, pipeline] = device_.createGraphicsPipeline(cache_, pipeline_info);
+        handle_result(result, "Failed to create graphics pipeline library part", ELogLvl::ERROR);
+
+        if (result != vk::Result::eSuccess) {
+            return nullptr;
+        }
+
+        log(ELogLvl::DEBUG, "Compiled pipeline library part {} in {:.2f} ms", cast<u32>(part), elapsed_ms(compile_start));
+
+        return pipeline;
+    }
+
+    auto PipelineLibrary::get_part(const EPart part, const PipelineDesc& desc) -> vk::Pipeline {
+        u64 part_hash = 0;
+        switch (part) {
+        case EPart::VERTEX_INPUT:
+            part_hash = desc.vertex_input_hash();
+            break;
+        case EPart::PRE_RASTERIZATION:
+            part_hash = desc.pre_rasterization_hash();
+            break;
+        case EPart::FRAGMENT_SHADER:
+            part_hash = desc.fragment_shader_hash();
+            break;
+        case EPart::FRAGMENT_OUTPUT:
+            part_hash = desc.fragment_output_hash();
+            break;
+        }
+
+        const u64 key = hash_combine(part_hash, cast<u64>(part));
+
+        {
+            std::scoped_lock lock(mutex_);
+            if (const auto it = parts_.find(key); it != parts_.end()) {
+                return it->second;
+            }
+        }
+
+        // compiled outside the lock, two workers racing on the same part is rare and the loser just throws its copy away
+        const auto compiled = compile_part(part, desc);
+        if (!compiled) {
+            return nullptr;
+        }
+
+        std::scoped_lock lock(mutex_);
+        const auto [it, inserted] = parts_.try_emplace(key, compiled);
+        if (!inserted) {
+            device_.destroyPipeline(compiled);
+        }
+
+        return it->second;
+    }
+
+    auto PipelineLibrary::link(const PipelineDesc& desc, const bool optimize) -> vk::Pipeline {
+        const auto link_start = std::chrono::steady_clock::now();
+
+        const std::array libraries = {
+            get_part(EPart::VERTEX_INPUT, desc),
+            get_part(EPart::PRE_RASTERIZATION, desc),
+            get_part(EPart::FRAGMENT_SHADER, desc),
+            get_part(EPart::FRAGMENT_OUTPUT, desc),
+        };
+
+        for (const auto library : libraries) {
+            if (!library) {
+                return nullptr;
+            }
+        }
+
+        const auto library_info = vk::PipelineLibraryCreateInfoKHR().setLibraries(libraries);
+
+        const auto pipeline_info = vk::GraphicsPipelineCreateInfo {
+            .pNext  = &library_info,
+            .flags  = base_flags_ | (optimize ? vk::PipelineCreateFlagBits::eLinkTimeOptimizationEXT : vk::PipelineCreateFlags {}),
+            .layout = desc.layout,
+        };
+
+        const auto [result, pipeline] = device_.createGraphicsPipeline(cache_, pipeline_info);
+        handle_result(result, "Failed to link graphics pipeline", ELogLvl::ERROR);
+
+        if (result != vk::Result::eSuccess) {
+            return nullptr;
+        }
+
+        log(ELogLvl::DEBUG,
+            "{} graphics pipeline {:#018x} in {:.2f} ms",
+            (optimize ? "Optimized" : "Fast-linked"),
+            desc.hash(),
+            elapsed_ms(link_start));
+
+        return pipeline;
+    }
+}  // namespace sylk
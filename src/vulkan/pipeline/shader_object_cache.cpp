@@ -0,0 +1,232 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/pipeline/shader_object_cache.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <array>
+
+constexpr const char* DEFAULT_SHADER_ENTRY_NAME = "main";
+
+namespace sylk {
+    void ShaderObjectCache::Program::bind(const vk::CommandBuffer cmd) const {
+        // tessellation and geometry shaders aren't enabled on the device, so these are the only stages that need a shader
+        const std::array stages  = {vk::ShaderStageFlagBits::eVertex, vk::ShaderStageFlagBits::eFragment};
+        const std::array shaders = {vertex, fragment};
+
+        cmd.bindShadersEXT(stages, shaders);
+        cmd.setPolygonModeEXT(polygon_mode);
+        cmd.setVertexInputEXT(vertex_bindings, vertex_attributes);
+    }
+
+    ShaderObjectCache::ShaderObjectCache(const vk::Device&          device,
+                                         const ShaderModuleCache&   shader_modules,
+                                         const PipelineLayoutCache& layouts)
+        : device_(device)
+        , shader_modules_(shader_modules)
+        , layouts_(layouts) {}
+
+    void ShaderObjectCache::destroy() {
+        for (const auto& [key, shader] : shaders_) {
+            device_.destroyShaderEXT(shader);
+        }
+
+        log(ELogLvl::TRACE, "Destroyed {} shader object(s)", shaders_.size());
+
+        shaders_.clear();
+        programs_.clear();
+        descs_.clear();
+    }
+
+    auto ShaderObjectCache::request(const PipelineDesc& desc) -> PipelineHandle {
+        // nothing but the shaders, their layout and the vertex input is part of a program
+        auto normalized       = desc;
+        normalized.renderpass = nullptr;
+        normalized.subpass    = 0;
+        normalized.state      = RenderState {};
+
+        const u64 key = normalized.hash();
+        if (programs_.contains(key)) {
+            return {key};
+        }
+
+        const auto* layout = layouts_.find(desc.layout);
+        if (!layout) {
+            log(ELogLvl::ERROR, "Shader objects can only be built against layouts from the layout cache");
+            return {};
+        }
+
+        auto program = std::make_unique<Program>();
+
+        // the stages aren't linked, so a stage shared with other programs is only ever compiled once
+        program->vertex = get_shader(vk::ShaderStageFlagBits::eVertex,
+                                     vk::ShaderStageFlagBits::eFragment,
+                                     desc.vertex_shader,
+                                     desc.vertex_specialization,
+                                     *layout);
+        program->fragment =
+            get_shader(vk::ShaderStageFlagBits::eFragment, {}, desc.fragment_shader, desc.fragment_specialization, *layout);
+        program->polygon_mode = desc.polygon_mode;
+
+        if (!program->vertex || !program->fragment) {
+            return {};
+        }
+
+        for (const auto& binding : desc.vertex_bindings) {
+            program->vertex_bindings.push_back({
+                .binding   = binding.binding,
+                .stride    = binding.stride,
+                .inputRate = binding.inputRate,
+                .divisor   = 1,
+            });
+        }
+
+        for (const auto& attribute : desc.vertex_attributes) {
+            program->vertex_attributes.push_back({
+                .location = attribute.location,
+                .binding  = attribute.binding,
+                .format   = attribute.format,
+                .offset   = attribute.offset,
+            });
+        }
+
+        programs_.emplace(key, std::move(program));
+        descs_.emplace(key, normalized);
+
+        return {key};
+    }
+
+    auto ShaderObjectCache::replace_module(const vk::ShaderModule from, const vk::ShaderModule to) -> u32 {
+        u32 rebuilt = 0;
+
+        for (auto& [key, desc] : descs_) {
+            if (desc.vertex_shader != from && desc.fragment_shader != from) {
+                continue;
+            }
+
+            auto replaced            = desc;
+            replaced.vertex_shader   = (desc.vertex_shader == from ? to : desc.vertex_shader);
+            replaced.fragment_shader = (desc.fragment_shader == from ? to : desc.fragment_shader);
+
+            const auto& layout   = *layouts_.find(desc.layout);
+            const auto  vertex   = get_shader(vk::ShaderStageFlagBits::eVertex,
+                                           vk::ShaderStageFlagBits::eFragment,
+                                           replaced.vertex_shader,
+                                           replaced.vertex_specialization,
+                                           layout);
+            const auto  fragment = get_shader(vk::ShaderStageFlagBits::eFragment,
+                                             {},
+                                             replaced.fragment_shader,
+                                             replaced.fragment_specialization,
+                                             layout);
+
+            if (!vertex || !fragment) {
+                log(ELogLvl::WARN, "Reloaded shader objects {:#018x} failed to build, keeping the previous ones", key);
+                continue;
+            }
+
+            // the replaced stages stay in the cache until destroy(), command buffers still in flight may use them
+            auto& program    = *programs_.at(key);
+            program.vertex   = vertex;
+            program.fragment = fragment;
+            desc             = replaced;
+
+            ++rebuilt;
+        }
+
+        return rebuilt;
+    }
+
+    auto ShaderObjectCache::resolve(const PipelineHandle handle, const PipelineHandle fallback) const -> const Program* {
+        if (const auto program = programs_.find(handle.key); program != programs_.end()) {
+            return program->second.get();
+        }
+
+        if (const auto program = programs_.find(fallback.key); program != programs_.end()) {
+            return program->second.get();
+        }
+
+        return nullptr;
+    }
+
+    auto ShaderObjectCache::shader_count() const -> u64 {
+        return shaders_.size();
+    }
+
+    void ShaderObjectCache::set_fixed_state(const vk::CommandBuffer cmd, const vk::Extent2D extent) {
+        // the same values the pipelines of the PipelineLibrary are built with
+        cmd.setViewportWithCount(vk::Viewport {
+            .width    = cast<f32>(extent.width),
+            .height   = cast<f32>(extent.height),
+            .maxDepth = 1.0f,
+        });
+        cmd.setScissorWithCount(vk::Rect2D {.extent = extent});
+
+        cmd.setRasterizerDiscardEnable(false);
+        cmd.setRasterizationSamplesEXT(vk::SampleCountFlagBits::e1);
+        cmd.setSampleMaskEXT(vk::SampleCountFlagBits::e1, vk::SampleMask {~0u});
+        cmd.setAlphaToCoverageEnableEXT(false);
+        cmd.setPrimitiveRestartEnable(false);
+        cmd.setDepthBiasEnable(false);
+        cmd.setStencilTestEnable(false);
+        cmd.setLineWidth(1.0f);
+        cmd.setColorWriteMaskEXT(0,
+                                 vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB |
+                                     vk::ColorComponentFlagBits::eA);
+    }
+
+    auto ShaderObjectCache::get_shader(const vk::ShaderStageFlagBits      stage,
+                                       const vk::ShaderStageFlags         next_stage,
+                                       const vk::ShaderModule             module,
+                                       const SpecializationData&          specialization,
+                                       const PipelineLayoutCache::Layout& layout) -> vk::ShaderEXT {
+        u64 key = FNV_OFFSET_BASIS;
+        key     = hash_combine(key, cast<u64>(static_cast<VkShaderStageFlags>(stage)));
+        key     = hash_combine(key, cast<u64>(static_cast<VkShaderStageFlags>(next_stage)));
+        key     = hash_combine(key, hash_value(static_cast<VkShaderModule>(module)));
+        key     = hash_combine(key, specialization.hash());
+        key     = hash_combine(key, hash_value(static_cast<VkPipelineLayout>(layout.pipeline_layout)));
+
+        if (const auto shader = shaders_.find(key); shader != shaders_.end()) {
+            return shader->second;
+        }
+
+        // shader objects are created from spir-v, the module only identifies which code that is
+        const auto code = shader_modules_.code(module);
+        if (code.empty()) {
+            log(ELogLvl::ERROR, "Shader module isn't owned by the shader module cache");
+            return nullptr;
+        }
+
+        const auto specialization_info = specialization.info();
+
+        const auto create_info =
+            vk::ShaderCreateInfoEXT {
+                .stage               = stage,
+                .nextStage           = next_stage,
+                .codeType            = vk::ShaderCodeTypeEXT::eSpirv,
+                .codeSize            = code.size_bytes(),
+                .pCode               = code.data(),
+                .pName               = DEFAULT_SHADER_ENTRY_NAME,
+                .pSpecializationInfo = (specialization.empty() ? nullptr : &specialization_info),
+            }
+                .setSetLayouts(layout.set_layouts)
+                .setPushConstantRanges(layout.push_constant_ranges);
+
+        const auto [result, shader] = device_.createShaderEXT(create_info);
+        handle_result(result, "Failed to create shader object", ELogLvl::ERROR);
+
+        if (result != vk::Result::eSuccess) {
+            return nullptr;
+        }
+
+        shaders_.emplace(key, shader);
+        log(ELogLvl::TRACE, "Created {} shader object {:#018x}", magic_enum::enum_name(stage), key);
+
+        return shader;
+    }
+}  // namespace sylk
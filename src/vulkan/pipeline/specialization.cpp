@@ -0,0 +1,28 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/pipeline/specialization.hpp>
+
+namespace sylk {
+    auto SpecializationData::empty() const -> bool {
+        return entries.empty();
+    }
+
+    auto SpecializationData::hash() const -> u64 {
+        u64 seed = FNV_OFFSET_BASIS;
+
+        for (const auto& entry : entries) {
+            seed = hash_combine(seed, entry.constantID);
+            seed = hash_combine(seed, entry.offset);
+            seed = hash_combine(seed, entry.size);
+        }
+
+        return fnv1a(data.data(), data.size(), seed);
+    }
+
+    auto SpecializationData::info() const -> vk::SpecializationInfo {
+        return vk::SpecializationInfo().setMapEntries(entries).setData<u8>(data);
+    }
+}  // namespace sylk
@@ -0,0 +1,40 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/render/draw_packet.hpp>
+
+#include <algorithm>
+
+namespace {
+    constexpr sylk::u32 DEPTH_BITS = 20;
+    constexpr sylk::u64 DEPTH_MAX  = (sylk::u64 {1} << DEPTH_BITS) - 1;
+
+    // xor folding keeps every bit of the input involved, so handles that differ anywhere are unlikely to collide
+    auto fold16(sylk::u64 value) -> sylk::u64 {
+        value ^= value >> 32;
+        value ^= value >> 16;
+        return value & 0xFFFFu;
+    }
+
+    auto quantize_depth(const sylk::f32 depth) -> sylk::u64 {
+        return sylk::cast<sylk::u64>(std::clamp(depth, 0.0f, 1.0f) * sylk::cast<sylk::f32>(DEPTH_MAX));
+    }
+}  // namespace
+
+namespace sylk {
+    auto make_draw_key(const DrawKeyInputs& inputs) -> u64 {
+        const auto pass     = cast<u64>(inputs.pass) & 0xFu;
+        const auto layer    = cast<u64>(inputs.layer);
+        const auto pipeline = fold16(inputs.pipeline.key);
+        const auto material = fold16(inputs.material);
+        const auto depth    = quantize_depth(inputs.depth);
+
+        if (inputs.pass == EDrawPass::TRANSPARENT) {
+            return (pass << 60) | (layer << 52) | ((DEPTH_MAX - depth) << 32) | (pipeline << 16) | material;
+        }
+
+        return (pass << 60) | (layer << 52) | (pipeline << 36) | (material << 20) | depth;
+    }
+}  // namespace sylk
@@ -0,0 +1,413 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/shaders/cull_comp.hpp>
+#include <sylk/shaders/cull_comp_reflection.hpp>
+#include <sylk/shaders/scene_vert.hpp>
+#include <sylk/shaders/scene_vert_reflection.hpp>
+#include <sylk/shaders/shader_frag_reflection.hpp>
+#include <sylk/vulkan/render/gpu_scene.hpp>
+#include <sylk/vulkan/shader/shader_reflection.hpp>
+#include <sylk/vulkan/shader/vertex.hpp>
+#include <sylk/vulkan/utils/constants.hpp>
+
+#define GLM_FORCE_RADIANS
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+static_assert(sizeof(sylk::Vertex) == sylk::SCENE_VERT_REFLECTION.vertex_stride, "Vertex no longer matches the inputs of scene.vert");
+static_assert(sylk::CULL_COMP_REFLECTION.push_constants.size() == 1 &&
+                  sizeof(sylk::CullConstants) == sylk::CULL_COMP_REFLECTION.push_constants[0].size,
+              "CullConstants no longer matches the push constants of cull.comp");
+
+namespace {
+    // set 2 of scene.vert and cull.comp, packed for their descriptor templates
+    struct DrawDescriptors {
+        vk::DescriptorBufferInfo objects;
+    };
+
+    struct CullDescriptors {
+        vk::DescriptorBufferInfo objects;
+        vk::DescriptorBufferInfo commands;
+        vk::DescriptorBufferInfo count;
+    };
+
+    // the rows of the matrix added and subtracted, with vulkan's depth range of [0, w] for the near plane
+    auto frustum_planes(const glm::mat4& m) -> std::array<glm::vec4, 6> {
+        const auto row = [&m](const int i) { return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]); };
+
+        std::array planes = {
+            row(3) + row(0),
+            row(3) - row(0),
+            row(3) + row(1),
+            row(3) - row(1),
+            row(2),
+            row(3) - row(2),
+        };
+
+        // normalized so the distance to a plane can be compared against a radius
+        for (auto& plane : planes) {
+            if (const auto length = glm::length(glm::vec3(plane)); length > 0.0f) {
+                plane /= length;
+            }
+        }
+
+        return planes;
+    }
+}  // namespace
+
+namespace sylk {
+    GpuScene::GpuScene(const vk::Device& device, ShaderModuleCache& shader_modules)
+        : device_(device)
+        , vertex_shader_(shader_modules)
+        , cull_pipeline_(device, shader_modules)
+        , draw_template_(device)
+        , upload_stream_(device) {}
+
+    void GpuScene::create(const vk::PhysicalDevice physical_device,
+                          const u32                frame_count,
+                          const u32                capacity,
+                          PipelineLayoutCache&     layouts,
+                          const vk::PipelineCache  cache,
+                          const DeviceFeatures&    features,
+                          DescriptorAllocator&     descriptor_allocator,
+                          DescriptorBuffer*        descriptor_buffer,
+                          const PipelineDesc&      base) {
+        descriptor_buffer_ = descriptor_buffer;
+        capacity_          = capacity;
+
+        vertex_shader_.create(SCENE_VERT);
+
+        // the scene is drawn between the other draws of a frame, the frame's sets and push constants have to survive
+        // binding it, which they only do if everything before the scene's own set agrees
+        const std::array stages      = {&SCENE_VERT_REFLECTION, &SHADER_FRAG_REFLECTION};
+        const auto&      draw_layout = layouts.get(stages);
+        const auto*      base_layout = layouts.find(base.layout);
+
+        const auto shared_sets = std::min<u64>(SET, (base_layout ? base_layout->set_layouts.size() : 0));
+        if (!base_layout || draw_layout.set_layouts.size() <= SET ||
+            !std::equal(base_layout->set_layouts.begin(), base_layout->set_layouts.begin() + shared_sets, draw_layout.set_layouts.begin()) ||
+            draw_layout.push_constant_ranges != base_layout->push_constant_ranges) {
+            log(ELogLvl::ERROR, "scene.vert no longer agrees with the default pipeline on the frame's sets and push constants");
+        }
+
+        desc_                   = base;
+        desc_.vertex_shader     = vertex_shader_.get_module();
+        desc_.layout            = draw_layout.pipeline_layout;
+        desc_.vertex_bindings   = vertex_binding_descriptions(SCENE_VERT_REFLECTION);
+        desc_.vertex_attributes = vertex_attribute_descriptions(SCENE_VERT_REFLECTION);
+
+        cull_pipeline_.create(CULL_COMP, CULL_COMP_REFLECTION, layouts, cache, features);
+        cull_constants_ = cull_pipeline_.push_constants<CullConstants>();
+
+        // descriptor buffers reference their buffers by address
+        const auto address_usage = (descriptor_buffer_ ? vk::BufferUsageFlagBits::eShaderDeviceAddress : vk::BufferUsageFlags {});
+
+        object_buffer_.create({
+            .data_to_map        = nullptr,
+            .device             = device_,
+            .physical_device    = physical_device,
+            .buffer_size        = capacity_ * sizeof(GpuObject),
+            .buffer_usage_flags = vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst | address_usage,
+            .property_flags     = vk::MemoryPropertyFlagBits::eDeviceLocal,
+        });
+
+        command_buffer_.create({
+            .data_to_map        = nullptr,
+            .device             = device_,
+            .physical_device    = physical_device,
+            .buffer_size        = capacity_ * sizeof(vk::DrawIndexedIndirectCommand),
+            .buffer_usage_flags = vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer | address_usage,
+            .property_flags     = vk::MemoryPropertyFlagBits::eDeviceLocal,
+        });
+
+        count_buffer_.create({
+            .data_to_map        = nullptr,
+            .device             = device_,
+            .physical_device    = physical_device,
+            .buffer_size        = sizeof(u32),
+            .buffer_usage_flags = vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer |
+                                  vk::BufferUsageFlagBits::eTransferDst | address_usage,
+            .property_flags = vk::MemoryPropertyFlagBits::eDeviceLocal,
+        });
+
+        upload_stream_.create(physical_device, vk::BufferUsageFlagBits::eTransferSrc, frame_count, GPU_SCENE_UPLOAD_FRAME_SIZE);
+
+        create_descriptors(draw_layout, descriptor_allocator);
+
+        log(ELogLvl::DEBUG, "Created gpu scene for up to {} object(s)", capacity_);
+    }
+
+    void GpuScene::create_descriptors(const PipelineLayoutCache::Layout& draw_layout, DescriptorAllocator& descriptor_allocator) {
+        const auto object_range  = capacity_ * sizeof(GpuObject);
+        const auto command_range = capacity_ * sizeof(vk::DrawIndexedIndirectCommand);
+        const auto count_range   = sizeof(u32);
+
+        const auto draw_set_layout = draw_layout.set_layouts[SET];
+        const auto cull_set_layout = cull_pipeline_.cached_layout().set_layouts[SET];
+
+        // the buffers never change, so both sets are written once and outlive every frame
+        if (descriptor_buffer_) {
+            constexpr auto type = vk::DescriptorType::eStorageBuffer;
+
+            draw_descriptors_ = descriptor_buffer_->allocate_persistent(draw_set_layout);
+            descriptor_buffer_->write_buffer(draw_descriptors_, draw_set_layout, 0, type, object_buffer_.device_address(device_), object_range);
+
+            cull_descriptors_ = descriptor_buffer_->allocate_persistent(cull_set_layout);
+            descriptor_buffer_->write_buffer(cull_descriptors_, cull_set_layout, 0, type, object_buffer_.device_address(device_), object_range);
+            descriptor_buffer_->write_buffer(cull_descriptors_, cull_set_layout, 1, type, command_buffer_.device_address(device_), command_range);
+            descriptor_buffer_->write_buffer(cull_descriptors_, cull_set_layout, 2, type, count_buffer_.device_address(device_), count_range);
+            return;
+        }
+
+        draw_template_.create(draw_layout, SET, false);
+        draw_set_ = descriptor_allocator.allocate_persistent(draw_set_layout);
+        draw_template_.update(draw_set_,
+                              DrawDescriptors {
+                                  .objects = ComputePipeline::storage_buffer(object_buffer_.vk_buffer(), 0, object_range),
+                              });
+
+        cull_set_ = descriptor_allocator.allocate_persistent(cull_set_layout);
+        cull_pipeline_.update(SET,
+                              cull_set_,
+                              CullDescriptors {
+                                  .objects  = ComputePipeline::storage_buffer(object_buffer_.vk_buffer(), 0, object_range),
+                                  .commands = ComputePipeline::storage_buffer(command_buffer_.vk_buffer(), 0, command_range),
+                                  .count    = ComputePipeline::storage_buffer(count_buffer_.vk_buffer(), 0, count_range),
+                              });
+    }
+
+    void GpuScene::destroy() {
+        upload_stream_.destroy();
+        object_buffer_.destroy_with(device_);
+        command_buffer_.destroy_with(device_);
+        count_buffer_.destroy_with(device_);
+
+        // the sets go away with the allocator or the descriptor buffer
+        if (draw_template_.valid()) {
+            draw_template_.destroy();
+        }
+
+        cull_pipeline_.destroy();
+
+        // the pipeline belongs to the library, the shader has to outlive any compile still in flight
+        vertex_shader_.destroy();
+
+        objects_.clear();
+        free_.clear();
+        dirty_.clear();
+        dirty_flags_.clear();
+        cleared_ = false;
+
+        log(ELogLvl::TRACE, "Destroyed gpu scene");
+    }
+
+    void GpuScene::set_handle(const PipelineHandle handle) {
+        handle_ = handle;
+    }
+
+    auto GpuScene::reload_shader(const std::string_view source_name, const std::span<const u32> code)
+        -> std::pair<vk::ShaderModule, vk::ShaderModule> {
+        if (source_name == "scene.vert") {
+            const auto replaced = vertex_shader_.reload(code);
+            desc_.vertex_shader = vertex_shader_.get_module();
+            return {replaced, (replaced ? desc_.vertex_shader : nullptr)};
+        }
+
+        return {};
+    }
+
+    auto GpuScene::add(const GpuObject& object) -> u32 {
+        u32 id;
+        if (!free_.empty()) {
+            id = free_.back();
+            free_.pop_back();
+            objects_[id] = object;
+        } else {
+            if (objects_.size() == capacity_) {
+                log(ELogLvl::CRITICAL, "Gpu scene ran out of object slots ({})", capacity_);
+            }
+
+            id = cast<u32>(objects_.size());
+            objects_.push_back(object);
+            dirty_flags_.push_back(false);
+        }
+
+        mark_dirty(id);
+        return id;
+    }
+
+    void GpuScene::update(const u32 id, const GpuObject& object) {
+        objects_[id] = object;
+        mark_dirty(id);
+    }
+
+    void GpuScene::remove(const u32 id) {
+        // an empty object is never drawn, the slot stays in the dispatch until it's reused
+        objects_[id] = GpuObject {};
+        mark_dirty(id);
+        free_.push_back(id);
+    }
+
+    void GpuScene::begin_frame(const u32 frame_slot) {
+        upload_stream_.begin_frame(frame_slot);
+    }
+
+    void GpuScene::cull(CommandEncoder& encoder, const glm::mat4& view_projection) {
+        view_projection_ = view_projection;
+
+        if (objects_.empty()) {
+            return;
+        }
+
+        const auto cmd = encoder.cmd();
+
+        // the previous frame still reads the objects and the commands this is about to overwrite, nothing of it has to
+        // become visible, the writes only have to wait for the reads
+        const auto reads_done = vk::MemoryBarrier2 {
+            .srcStageMask = vk::PipelineStageFlagBits2::eDrawIndirect | vk::PipelineStageFlagBits2::eVertexShader |
+                            vk::PipelineStageFlagBits2::eComputeShader,
+            .dstStageMask = vk::PipelineStageFlagBits2::eAllTransfer | vk::PipelineStageFlagBits2::eComputeShader,
+        };
+        cmd.pipelineBarrier2(vk::DependencyInfo().setMemoryBarriers(reads_done));
+
+        // slots that were never uploaded have to read as empty rather than as whatever the memory held
+        if (!cleared_) {
+            cmd.fillBuffer(object_buffer_.vk_buffer(), 0, VK_WHOLE_SIZE, 0);
+
+            const auto cleared = vk::MemoryBarrier2 {
+                .srcStageMask  = vk::PipelineStageFlagBits2::eClear,
+                .srcAccessMask = vk::AccessFlagBits2::eTransferWrite,
+                .dstStageMask  = vk::PipelineStageFlagBits2::eCopy,
+                .dstAccessMask = vk::AccessFlagBits2::eTransferWrite,
+            };
+            cmd.pipelineBarrier2(vk::DependencyInfo().setMemoryBarriers(cleared));
+            cleared_ = true;
+        }
+
+        upload(cmd);
+        cmd.fillBuffer(count_buffer_.vk_buffer(), 0, sizeof(u32), 0);
+
+        const auto uploaded = vk::MemoryBarrier2 {
+            .srcStageMask  = vk::PipelineStageFlagBits2::eAllTransfer,
+            .srcAccessMask = vk::AccessFlagBits2::eTransferWrite,
+            .dstStageMask  = vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eVertexShader,
+            .dstAccessMask = vk::AccessFlagBits2::eShaderStorageRead | vk::AccessFlagBits2::eShaderStorageWrite,
+        };
+        cmd.pipelineBarrier2(vk::DependencyInfo().setMemoryBarriers(uploaded));
+
+        encoder.bind_pipeline(vk::PipelineBindPoint::eCompute, cull_pipeline_.get_handle());
+        if (descriptor_buffer_) {
+            descriptor_buffer_->set_offset(cmd, vk::PipelineBindPoint::eCompute, cull_pipeline_.get_layout(), SET, cull_descriptors_);
+        } else {
+            encoder.bind_descriptor_set(vk::PipelineBindPoint::eCompute, cull_pipeline_.get_layout(), SET, cull_set_);
+        }
+
+        const auto object_count = cast<u32>(objects_.size());
+        cull_constants_.push(cmd, CullConstants {.planes = frustum_planes(view_projection), .object_count = object_count});
+        cull_pipeline_.dispatch_invocations(cmd, object_count);
+
+        ComputePipeline::barrier(cmd, vk::PipelineStageFlagBits2::eDrawIndirect, vk::AccessFlagBits2::eIndirectCommandRead);
+    }
+
+    void GpuScene::record(CommandEncoder& encoder, const PushConstants<DrawConstants>& draw_constants) const {
+        if (objects_.empty()) {
+            return;
+        }
+
+        const auto cmd = encoder.cmd();
+
+        if (descriptor_buffer_) {
+            descriptor_buffer_->set_offset(cmd, vk::PipelineBindPoint::eGraphics, desc_.layout, SET, draw_descriptors_);
+        } else {
+            encoder.bind_descriptor_set(vk::PipelineBindPoint::eGraphics, desc_.layout, SET, draw_set_);
+        }
+
+        draw_constants.push(cmd, DrawConstants {.model = view_projection_});
+
+        // the count never exceeds the slots that were culled, which is what bounds the draws read from the buffer
+        cmd.drawIndexedIndirectCount(command_buffer_.vk_buffer(),
+                                     0,
+                                     count_buffer_.vk_buffer(),
+                                     0,
+                                     cast<u32>(objects_.size()),
+                                     sizeof(vk::DrawIndexedIndirectCommand));
+    }
+
+    void GpuScene::mark_dirty(const u32 id) {
+        if (!dirty_flags_[id]) {
+            dirty_flags_[id] = true;
+            dirty_.push_back(id);
+        }
+    }
+
+    void GpuScene::upload(const vk::CommandBuffer cmd) {
+        if (dirty_.empty()) {
+            return;
+        }
+
+        // whatever doesn't fit this frame's region stays dirty and goes out with the next frame
+        const auto room  = (upload_stream_.frame_size() - upload_stream_.used()) / sizeof(GpuObject);
+        const auto count = std::min<u64>(dirty_.size(), room);
+        if (count == 0) {
+            return;
+        }
+
+        const auto allocation = upload_stream_.allocate(count * sizeof(GpuObject), alignof(GpuObject));
+        if (!allocation) {
+            return;
+        }
+
+        // oldest changes go first so none of them wait forever, ids added in a row end up in one copy region
+        copies_.clear();
+        for (u64 i = 0; i < count; ++i) {
+            const u32 id = dirty_[i];
+            std::memcpy(allocation.data + i * sizeof(GpuObject), &objects_[id], sizeof(GpuObject));
+            dirty_flags_[id] = false;
+
+            const auto src_offset = allocation.offset + i * sizeof(GpuObject);
+            const auto dst_offset = cast<vk::DeviceSize>(id) * sizeof(GpuObject);
+
+            if (!copies_.empty() && copies_.back().srcOffset + copies_.back().size == src_offset &&
+                copies_.back().dstOffset + copies_.back().size == dst_offset) {
+                copies_.back().size += sizeof(GpuObject);
+                continue;
+            }
+
+            copies_.push_back({.srcOffset = src_offset, .dstOffset = dst_offset, .size = sizeof(GpuObject)});
+        }
+
+        // only moves the ids that didn't fit, which is nothing unless the region overflowed
+        dirty_.erase(dirty_.begin(), dirty_.begin() + count);
+        cmd.copyBuffer(upload_stream_.vk_buffer(), object_buffer_.vk_buffer(), copies_);
+    }
+
+    auto GpuScene::desc() const -> const PipelineDesc& {
+        return desc_;
+    }
+
+    auto GpuScene::handle() const -> PipelineHandle {
+        return handle_;
+    }
+
+    auto GpuScene::object_count() const -> u32 {
+        return cast<u32>(objects_.size() - free_.size());
+    }
+
+    auto GpuScene::pending_uploads() const -> u32 {
+        return cast<u32>(dirty_.size());
+    }
+
+    auto GpuScene::empty() const -> bool {
+        return objects_.empty();
+    }
+
+    auto GpuScene::valid() const -> bool {
+        return upload_stream_.valid();
+    }
+}  // namespace sylk
@@ -0,0 +1,240 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/core/utils/radix_sort.hpp>
+#include <sylk/shaders/sprite_frag.hpp>
+#include <sylk/shaders/sprite_frag_reflection.hpp>
+#include <sylk/shaders/sprite_vert.hpp>
+#include <sylk/shaders/sprite_vert_reflection.hpp>
+#include <sylk/vulkan/pipeline/specialization.hpp>
+#include <sylk/vulkan/render/sprite_batch.hpp>
+#include <sylk/vulkan/shader/shader_reflection.hpp>
+#include <sylk/vulkan/shader/sprite_instance.hpp>
+#include <sylk/vulkan/utils/constants.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+#define GLM_FORCE_RADIANS
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <array>
+
+static_assert(sylk::SPRITE_VERT_REFLECTION.vertex_stride == 0 &&
+                  sizeof(sylk::SpriteInstance) == sylk::SPRITE_VERT_REFLECTION.instance_stride,
+              "SpriteInstance no longer matches the inputs of sprite.vert");
+static_assert(sylk::BindlessTable::MAX_IMAGES <= 0x10000, "Bindless image indices no longer fit the 16 bits of a sprite key");
+
+namespace {
+    // six vertices make the two triangles of a quad, see sprite.vert
+    constexpr sylk::u32 SPRITE_VERTEX_COUNT = 6;
+
+    // layer, then image, then the position in the frame, so equal sprites keep the order they were submitted in
+    // flipping the sign bit makes negative layers sort below positive ones as unsigned integers
+    auto sort_key(const sylk::Sprite& sprite, const sylk::u32 sequence) -> sylk::u64 {
+        const auto layer = sylk::cast<sylk::u64>(sylk::cast<sylk::u16>(sprite.layer) ^ 0x8000u);
+        const auto image = sylk::cast<sylk::u64>(sprite.region.image & 0xFFFFu);
+
+        return (layer << 48) | (image << 32) | sequence;
+    }
+
+    auto key_image(const sylk::u64 key) -> sylk::u32 {
+        return sylk::cast<sylk::u32>((key >> 32) & 0xFFFFu);
+    }
+
+    auto key_sequence(const sylk::u64 key) -> sylk::u32 {
+        return sylk::cast<sylk::u32>(key);
+    }
+}  // namespace
+
+namespace sylk {
+    SpriteBatch::SpriteBatch(const vk::Device& device, ShaderModuleCache& shader_modules)
+        : device_(device)
+        , vertex_shader_(shader_modules)
+        , fragment_shader_(shader_modules)
+        , instance_stream_(device) {}
+
+    void SpriteBatch::create(const vk::PhysicalDevice physical_device,
+                             const u32                frame_count,
+                             BindlessTable&           bindless_table,
+                             PipelineLayoutCache&     layouts,
+                             const PipelineDesc&      base) {
+        bindless_table_ = &bindless_table;
+
+        // atlas cells are padded by whoever packs them, clamping only keeps the page edges from bleeding into each other
+        const auto sampler_info = vk::SamplerCreateInfo {
+            .magFilter    = vk::Filter::eLinear,
+            .minFilter    = vk::Filter::eLinear,
+            .mipmapMode   = vk::SamplerMipmapMode::eNearest,
+            .addressModeU = vk::SamplerAddressMode::eClampToEdge,
+            .addressModeV = vk::SamplerAddressMode::eClampToEdge,
+            .addressModeW = vk::SamplerAddressMode::eClampToEdge,
+            .maxLod       = 0.0f,
+        };
+
+        const auto [result, sampler] = device_.createSampler(sampler_info);
+        handle_result(result, "Failed to create sprite sampler", ELogLvl::CRITICAL);
+        sampler_       = sampler;
+        sampler_index_ = bindless_table.add_sampler(sampler_);
+
+        vertex_shader_.create(SPRITE_VERT);
+        fragment_shader_.create(SPRITE_FRAG);
+
+        // sprites are drawn between the other draws of a frame without rebinding anything, so the layouts have to be
+        // one and the same
+        const std::array stages = {&SPRITE_VERT_REFLECTION, &SPRITE_FRAG_REFLECTION};
+        if (layouts.get(stages).pipeline_layout != base.layout) {
+            log(ELogLvl::ERROR, "sprite.vert and sprite.frag no longer agree with the default pipeline on their bindings and push constants");
+        }
+
+        // the sampler never changes, so it's baked in rather than passed along with every sprite
+        const auto sampler_constant = SpecializationSet<SPRITE_FRAG_REFLECTION, SpecConstant<0, u32>>({sampler_index_});
+
+        desc_                         = base;
+        desc_.vertex_shader           = vertex_shader_.get_module();
+        desc_.fragment_shader         = fragment_shader_.get_module();
+        desc_.vertex_specialization   = {};
+        desc_.fragment_specialization = sampler_constant.data();
+        desc_.vertex_bindings         = vertex_binding_descriptions(SPRITE_VERT_REFLECTION);
+        desc_.vertex_attributes       = vertex_attribute_descriptions(SPRITE_VERT_REFLECTION);
+        desc_.state                   = RenderState {.cull_mode = vk::CullModeFlagBits::eNone, .blend = EBlendMode::ALPHA};
+
+        instance_stream_.create(physical_device, vk::BufferUsageFlagBits::eVertexBuffer, frame_count, SPRITE_STREAM_FRAME_SIZE);
+
+        log(ELogLvl::DEBUG, "Created sprite batch");
+    }
+
+    void SpriteBatch::destroy() {
+        instance_stream_.destroy();
+
+        bindless_table_->release_sampler(sampler_index_);
+        device_.destroySampler(sampler_);
+        sampler_ = nullptr;
+
+        // the pipeline belongs to the library, the shaders have to outlive any compile still in flight
+        vertex_shader_.destroy();
+        fragment_shader_.destroy();
+
+        sprites_.clear();
+        keys_.clear();
+        batches_.clear();
+
+        log(ELogLvl::TRACE, "Destroyed sprite batch");
+    }
+
+    void SpriteBatch::set_handle(const PipelineHandle handle) {
+        handle_ = handle;
+    }
+
+    auto SpriteBatch::reload_shader(const std::string_view source_name, const std::span<const u32> code)
+        -> std::pair<vk::ShaderModule, vk::ShaderModule> {
+        if (source_name == "sprite.vert") {
+            const auto replaced = vertex_shader_.reload(code);
+            desc_.vertex_shader = vertex_shader_.get_module();
+            return {replaced, (replaced ? desc_.vertex_shader : nullptr)};
+        }
+
+        if (source_name == "sprite.frag") {
+            const auto replaced   = fragment_shader_.reload(code);
+            desc_.fragment_shader = fragment_shader_.get_module();
+            return {replaced, (replaced ? desc_.fragment_shader : nullptr)};
+        }
+
+        return {};
+    }
+
+    void SpriteBatch::build(std::vector<Sprite>& sprites) {
+        // swapping rather than copying keeps both vectors' capacity around for the next frame
+        sprites_.clear();
+        sprites_.swap(sprites);
+
+        keys_.clear();
+        keys_.reserve(sprites_.size());
+        for (u32 i = 0; i < sprites_.size(); ++i) {
+            keys_.push_back(sort_key(sprites_[i], i));
+        }
+
+        // most frames submit their sprites grouped already, checking is a lot cheaper than sorting
+        // the sort is stable and the sequence in the low half is ascending to begin with, so only the high half is sorted
+        if (!std::ranges::is_sorted(keys_)) {
+            key_scratch_.resize(keys_.size());
+            radix_sort(std::span<u64>(keys_), std::span<u64>(key_scratch_), [](const u64 key) { return key >> 32; }, SORT_THREADS);
+        }
+
+        // a layer boundary doesn't break a batch, the instances of a draw are drawn in order
+        batches_.clear();
+        for (u32 i = 0; i < keys_.size(); ++i) {
+            const auto image = key_image(keys_[i]);
+            if (batches_.empty() || batches_.back().image != image) {
+                batches_.push_back({.image = image, .first = i, .count = 0});
+            }
+
+            ++batches_.back().count;
+        }
+    }
+
+    void SpriteBatch::begin_frame(const u32 frame_slot) {
+        instance_stream_.begin_frame(frame_slot);
+    }
+
+    void SpriteBatch::record(CommandEncoder& encoder, const PushConstants<DrawConstants>& draw_constants, const vk::Extent2D extent) {
+        if (keys_.empty()) {
+            return;
+        }
+
+        const auto allocation = instance_stream_.allocate(keys_.size() * sizeof(SpriteInstance), alignof(SpriteInstance));
+        if (!allocation) {
+            return;
+        }
+
+        // gathered in sorted order, so the mapped memory is only ever written front to back
+        auto* instances = reinterpret_cast<SpriteInstance*>(allocation.data);
+        for (u64 i = 0; i < keys_.size(); ++i) {
+            const auto& sprite = sprites_[key_sequence(keys_[i])];
+
+            instances[i] = SpriteInstance {
+                .position = sprite.position,
+                .size     = sprite.size,
+                .uv_rect  = sprite.region.uv_rect,
+                .rotation = sprite.rotation,
+                .color    = glm::packUnorm4x8(sprite.color),
+            };
+        }
+
+        encoder.bind_vertex_buffer(INSTANCE_BINDING, instance_stream_.vk_buffer(), allocation.offset);
+
+        // pixels with the origin in the top left, vulkan's clip space already points y down
+        auto constants = DrawConstants {
+            .model = glm::ortho(0.0f, cast<f32>(extent.width), 0.0f, cast<f32>(extent.height)),
+        };
+
+        const auto cmd = encoder.cmd();
+        for (const auto& batch : batches_) {
+            constants.material_index = batch.image;
+            draw_constants.push(cmd, constants);
+            cmd.draw(SPRITE_VERTEX_COUNT, batch.count, 0, batch.first);
+        }
+    }
+
+    auto SpriteBatch::desc() const -> const PipelineDesc& {
+        return desc_;
+    }
+
+    auto SpriteBatch::handle() const -> PipelineHandle {
+        return handle_;
+    }
+
+    auto SpriteBatch::stats() const -> Stats {
+        return {.sprites = cast<u32>(keys_.size()), .batches = cast<u32>(batches_.size())};
+    }
+
+    auto SpriteBatch::empty() const -> bool {
+        return keys_.empty();
+    }
+
+    auto SpriteBatch::valid() const -> bool {
+        return instance_stream_.valid();
+    }
+}  // namespace sylk
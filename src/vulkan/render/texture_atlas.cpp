@@ -0,0 +1,55 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/render/texture_atlas.hpp>
+
+namespace sylk {
+    auto TextureAtlas::add_page(const u32 image, const vk::Extent2D extent) -> u32 {
+        pages_.push_back({.image = image, .extent = extent});
+        return cast<u32>(pages_.size() - 1);
+    }
+
+    auto TextureAtlas::add_region(const u32 page, const vk::Rect2D pixels) -> u32 {
+        const auto& [image, extent] = pages_.at(page);
+
+        const auto width  = cast<f32>(extent.width);
+        const auto height = cast<f32>(extent.height);
+
+        regions_.push_back({
+            .image   = image,
+            .uv_rect = {cast<f32>(pixels.offset.x) / width,
+                        cast<f32>(pixels.offset.y) / height,
+                        cast<f32>(pixels.extent.width) / width,
+                        cast<f32>(pixels.extent.height) / height},
+        });
+
+        return cast<u32>(regions_.size() - 1);
+    }
+
+    auto TextureAtlas::add_grid(const u32 page, const vk::Extent2D cell) -> u32 {
+        const auto extent = pages_.at(page).extent;
+        const auto first  = cast<u32>(regions_.size());
+
+        for (u32 y = 0; y + cell.height <= extent.height; y += cell.height) {
+            for (u32 x = 0; x + cell.width <= extent.width; x += cell.width) {
+                add_region(page, {.offset = {cast<i32>(x), cast<i32>(y)}, .extent = cell});
+            }
+        }
+
+        return first;
+    }
+
+    auto TextureAtlas::region(const u32 id) const -> const AtlasRegion& {
+        return regions_.at(id);
+    }
+
+    auto TextureAtlas::region_count() const -> u32 {
+        return cast<u32>(regions_.size());
+    }
+
+    auto TextureAtlas::page_count() const -> u32 {
+        return cast<u32>(pages_.size());
+    }
+}  // namespace sylk
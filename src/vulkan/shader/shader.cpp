@@ -4,49 +4,43 @@
 
 #include <sylk/core/utils/all.hpp>
 #include <sylk/vulkan/shader/shader.hpp>
-#include <sylk/vulkan/utils/result_handler.hpp>
-
-#include <fstream>
 
 namespace sylk {
-    Shader::Shader(const vk::Device& device)
-        : device_(device) {}
+    Shader::Shader(ShaderModuleCache& cache)
+        : cache_(cache) {}
 
-    void Shader::create(const char* filename) {
-        // start at end of file so size is easily known
-        std::ifstream file(filename, std::ios::ate | std::ios::binary);
+    void Shader::create(const std::span<const u32> code) {
+        shader_module_ = cache_.acquire(code);
 
-        if (not file.is_open()) {
-            log(ELogLvl::CRITICAL, "Failed to open shader file: {}", filename);
+        if (!shader_module_) {
+            log(ELogLvl::CRITICAL, "Failed to create shader module");
         }
+    }
 
-        u64 file_size = cast<u64>(file.tellg());
-        shader_code_.resize(file_size);
-
-        // go back to start of file for reading
-        file.seekg(0);
-        file.read(shader_code_.data(), file_size);
+    void Shader::destroy() {
+        cache_.release(shader_module_);
+        shader_module_ = nullptr;
 
-        create_shader_module();
+        for (const auto module : replaced_modules_) {
+            cache_.release(module);
+        }
+        replaced_modules_.clear();
     }
 
-    void Shader::create_shader_module() {
-        // casting from char is well defined, so this does not break strict
-        // aliasing rules alignment is also not an issue due to how vector
-        // allocates its data also, vulkan guarantees the endianness of the host
-        // and device are the same, and the sorts of machines that sylk targets
-        // are highly likely to be in the expected endianness
-        const auto create_info = vk::ShaderModuleCreateInfo {
-            .codeSize = shader_code_.size(),
-            .pCode    = reinterpret_cast<const u32*>(shader_code_.data()),
-        };
-
-        const auto [result, shader] = device_.createShaderModule(create_info);
-        handle_result(result, "Failed to create shader module");
-        shader_module_ = shader;
-    }
+    auto Shader::reload(const std::span<const u32> code) -> vk::ShaderModule {
+        const auto module = cache_.acquire(code);
 
-    void Shader::destroy() { device_.destroyShaderModule(shader_module_); }
+        // saving a file without changing it hands back the module that's already in use
+        if (!module || module == shader_module_) {
+            cache_.release(module);
+            return nullptr;
+        }
+
+        replaced_modules_.push_back(shader_module_);
+        shader_module_ = module;
+
+        return replaced_modules_.back();
+    }
 
     auto Shader::get_module() const -> vk::ShaderModule { return shader_module_; }
 }
@@ -0,0 +1,192 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#ifdef SYLK_SHADER_HOT_RELOAD
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/shader/shader_hot_reload.hpp>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <string_view>
+
+namespace {
+    // editors tend to write a file in several steps, events that arrive this close together are handled as one change
+    constexpr auto      SETTLE_TIME     = std::chrono::milliseconds(50);
+    constexpr sylk::i32 POLL_TIMEOUT_MS = 100;
+    constexpr sylk::u32 WATCHED_EVENTS  = IN_CLOSE_WRITE | IN_MOVED_TO;
+
+    auto read_spirv(const std::filesystem::path& path) -> std::vector<sylk::u32> {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return {};
+        }
+
+        const auto size = static_cast<std::streamsize>(file.tellg());
+        if (size <= 0 || size % sizeof(sylk::u32) != 0) {
+            return {};
+        }
+
+        std::vector<sylk::u32> code(size / sizeof(sylk::u32));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(code.data()), size);
+
+        return code;
+    }
+}  // namespace
+
+namespace sylk {
+    void ShaderHotReload::create() {
+        inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify_fd_ < 0) {
+            log(ELogLvl::ERROR, "Failed to initialize inotify, shaders won't be hot reloaded");
+            return;
+        }
+
+        source_watch_  = inotify_add_watch(inotify_fd_, SYLK_SHADER_SOURCE_DIR, WATCHED_EVENTS);
+        include_watch_ = inotify_add_watch(inotify_fd_, SYLK_SHADER_INCLUDE_DIR, WATCHED_EVENTS);
+
+        if (source_watch_ < 0) {
+            log(ELogLvl::ERROR, "Failed to watch {}, shaders won't be hot reloaded", SYLK_SHADER_SOURCE_DIR);
+            destroy();
+            return;
+        }
+
+        std::filesystem::create_directories(SYLK_SHADER_RELOAD_DIR);
+        watcher_ = std::jthread([this](const std::stop_token& stop_token) { watch(stop_token); });
+
+        log(ELogLvl::INFO, "Watching {} for shader changes", SYLK_SHADER_SOURCE_DIR);
+    }
+
+    void ShaderHotReload::destroy() {
+        // jthreads request a stop and join when they're replaced
+        watcher_ = {};
+
+        if (inotify_fd_ >= 0) {
+            close(inotify_fd_);
+        }
+
+        inotify_fd_    = -1;
+        source_watch_  = -1;
+        include_watch_ = -1;
+
+        compiled_.clear();
+        code_.clear();
+    }
+
+    auto ShaderHotReload::poll() -> std::vector<Reload> {
+        std::vector<Compiled> compiled;
+
+        {
+            std::scoped_lock lock(mutex_);
+            compiled.swap(compiled_);
+        }
+
+        std::vector<Reload> reloads;
+        reloads.reserve(compiled.size());
+
+        for (auto& shader : compiled) {
+            // moving the vector keeps its storage, so the span stays valid for as long as the deque holds it
+            const auto& code = code_.emplace_back(std::move(shader.code));
+            reloads.push_back({.source_name = std::move(shader.source_name), .code = code});
+        }
+
+        return reloads;
+    }
+
+    void ShaderHotReload::watch(const std::stop_token& stop_token) {
+        alignas(inotify_event) std::array<char, 4096> buffer;
+
+        while (!stop_token.stop_requested()) {
+            pollfd descriptor {.fd = inotify_fd_, .events = POLLIN};
+            if (::poll(&descriptor, 1, POLL_TIMEOUT_MS) <= 0) {
+                continue;
+            }
+
+            std::this_thread::sleep_for(SETTLE_TIME);
+
+            std::set<std::filesystem::path> changed;
+            bool                             include_changed = false;
+
+            // the descriptor is non-blocking, reading stops once everything that queued up meanwhile is drained
+            ssize_t length = 0;
+            while ((length = read(inotify_fd_, buffer.data(), buffer.size())) > 0) {
+                for (ssize_t offset = 0; offset < length;) {
+                    const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+                    offset += sizeof(inotify_event) + event->len;
+
+                    if (event->len == 0) {
+                        continue;
+                    }
+
+                    // swap files and backups of editors show up here as well, names starting with a dot or ending in a
+                    // tilde are skipped, the name is padded with nulls up to len so its end has to be searched for
+                    const std::string_view name(event->name);
+                    if (name.empty() || name.front() == '.' || name.back() == '~') {
+                        continue;
+                    }
+
+                    if (event->wd == include_watch_) {
+                        include_changed = true;
+                    } else if (event->wd == source_watch_) {
+                        changed.insert(std::filesystem::path(SYLK_SHADER_SOURCE_DIR) / event->name);
+                    }
+                }
+            }
+
+            if (include_changed) {
+                for (const auto& entry : std::filesystem::directory_iterator(SYLK_SHADER_SOURCE_DIR)) {
+                    if (entry.is_regular_file()) {
+                        changed.insert(entry.path());
+                    }
+                }
+            }
+
+            for (const auto& source : changed) {
+                compile(source);
+            }
+        }
+    }
+
+    auto ShaderHotReload::compile(const std::filesystem::path& source) -> bool {
+        const auto compile_start = std::chrono::steady_clock::now();
+        const auto source_name   = source.filename().string();
+        const auto output        = std::filesystem::path(SYLK_SHADER_RELOAD_DIR) / (source_name + ".spv");
+
+        // glslc reports its own errors, the build optimizes shaders but that isn't worth the wait here
+        const auto command = fmt::format(R"("{}" --target-env=vulkan1.3 -I "{}" "{}" -o "{}")",
+                                         SYLK_GLSLC_EXECUTABLE,
+                                         SYLK_SHADER_INCLUDE_DIR,
+                                         source.string(),
+                                         output.string());
+
+        if (std::system(command.c_str()) != 0) {
+            log(ELogLvl::ERROR, "Failed to compile {}, keeping the previous version", source_name);
+            return false;
+        }
+
+        auto code = read_spirv(output);
+        if (code.empty()) {
+            log(ELogLvl::ERROR, "Failed to read the compiled {}", source_name);
+            return false;
+        }
+
+        const auto elapsed = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - compile_start);
+        log(ELogLvl::DEBUG, "Recompiled {} in {:.2f} ms", source_name, elapsed.count());
+
+        std::scoped_lock lock(mutex_);
+        compiled_.push_back({.source_name = source_name, .code = std::move(code)});
+
+        return true;
+    }
+}  // namespace sylk
+
+#endif  // SYLK_SHADER_HOT_RELOAD
@@ -0,0 +1,115 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/shader/shader_module_cache.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+#include <algorithm>
+
+namespace sylk {
+    ShaderModuleCache::ShaderModuleCache(const vk::Device& device)
+        : device_(device) {}
+
+    void ShaderModuleCache::destroy() {
+        std::scoped_lock lock(mutex_);
+
+        for (const auto& [key, entry] : entries_) {
+            log(ELogLvl::WARN, "Shader module still had {} reference(s) at shutdown", entry.references);
+            device_.destroyShaderModule(entry.module);
+        }
+
+        entries_.clear();
+        keys_.clear();
+    }
+
+    auto ShaderModuleCache::acquire(const std::span<const u32> code) -> vk::ShaderModule {
+        const u64 key = fnv1a(code.data(), code.size_bytes());
+
+        std::scoped_lock lock(mutex_);
+
+        // the code is compared as well, two blobs sharing a hash must not share a module
+        const auto [first, last] = entries_.equal_range(key);
+        for (auto it = first; it != last; ++it) {
+            if (std::ranges::equal(it->second.code, code)) {
+                ++it->second.references;
+                return it->second.module;
+            }
+        }
+
+        // the driver copies the code, so the module can be created straight from the embedded array
+        const auto create_info = vk::ShaderModuleCreateInfo {
+            .codeSize = code.size_bytes(),
+            .pCode    = code.data(),
+        };
+
+        const auto [result, module] = device_.createShaderModule(create_info);
+        handle_result(result, "Failed to create shader module", ELogLvl::ERROR);
+
+        if (result != vk::Result::eSuccess) {
+            return nullptr;
+        }
+
+        entries_.emplace(key, Entry {.code = code, .module = module, .references = 1});
+        keys_.emplace(module, key);
+
+        log(ELogLvl::TRACE, "Created shader module {:#018x} ({} bytes)", key, code.size_bytes());
+
+        return module;
+    }
+
+    void ShaderModuleCache::release(const vk::ShaderModule module) {
+        if (!module) {
+            return;
+        }
+
+        std::scoped_lock lock(mutex_);
+
+        const auto key = keys_.find(module);
+        if (key == keys_.end()) {
+            log(ELogLvl::ERROR, "Released a shader module that isn't owned by the cache");
+            return;
+        }
+
+        const auto [first, last] = entries_.equal_range(key->second);
+        for (auto it = first; it != last; ++it) {
+            if (it->second.module != module) {
+                continue;
+            }
+
+            if (--it->second.references == 0) {
+                device_.destroyShaderModule(module);
+                log(ELogLvl::TRACE, "Destroyed shader module {:#018x}", key->second);
+
+                entries_.erase(it);
+                keys_.erase(key);
+            }
+
+            return;
+        }
+    }
+
+    auto ShaderModuleCache::code(const vk::ShaderModule module) const -> std::span<const u32> {
+        std::scoped_lock lock(mutex_);
+
+        const auto key = keys_.find(module);
+        if (key == keys_.end()) {
+            return {};
+        }
+
+        const auto [first, last] = entries_.equal_range(key->second);
+        for (auto it = first; it != last; ++it) {
+            if (it->second.module == module) {
+                return it->second.code;
+            }
+        }
+
+        return {};
+    }
+
+    auto ShaderModuleCache::module_count() const -> u64 {
+        std::scoped_lock lock(mutex_);
+        return entries_.size();
+    }
+}  // namespace sylk
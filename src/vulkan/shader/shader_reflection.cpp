@@ -0,0 +1,45 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/vulkan/shader/shader_reflection.hpp>
+
+namespace sylk {
+    auto vertex_binding_descriptions(const ShaderReflection& reflection) -> std::vector<vk::VertexInputBindingDescription> {
+        std::vector<vk::VertexInputBindingDescription> descriptions;
+
+        if (reflection.vertex_stride > 0) {
+            descriptions.push_back({
+                .binding   = VERTEX_BINDING,
+                .stride    = reflection.vertex_stride,
+                .inputRate = vk::VertexInputRate::eVertex,
+            });
+        }
+
+        if (reflection.instance_stride > 0) {
+            descriptions.push_back({
+                .binding   = INSTANCE_BINDING,
+                .stride    = reflection.instance_stride,
+                .inputRate = vk::VertexInputRate::eInstance,
+            });
+        }
+
+        return descriptions;
+    }
+
+    auto vertex_attribute_descriptions(const ShaderReflection& reflection) -> std::vector<vk::VertexInputAttributeDescription> {
+        std::vector<vk::VertexInputAttributeDescription> descriptions;
+        descriptions.reserve(reflection.vertex_inputs.size());
+
+        for (const auto& input : reflection.vertex_inputs) {
+            descriptions.push_back({
+                .location = input.location,
+                .binding  = (input.rate == vk::VertexInputRate::eInstance ? INSTANCE_BINDING : VERTEX_BINDING),
+                .format   = input.format,
+                .offset   = input.offset,
+            });
+        }
+
+        return descriptions;
+    }
+}  // namespace sylk
@@ -0,0 +1,57 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/sync/timeline_semaphore.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+namespace sylk {
+    TimelineSemaphore::TimelineSemaphore(const vk::Device& device)
+        : device_(device)
+        , last_claimed_value_(0) {}
+
+    void TimelineSemaphore::create(const u64 initial_value) {
+        const auto type_info = vk::SemaphoreTypeCreateInfo {
+            .semaphoreType = vk::SemaphoreType::eTimeline,
+            .initialValue  = initial_value,
+        };
+
+        const auto [result, semaphore] = device_.createSemaphore(vk::SemaphoreCreateInfo {.pNext = &type_info});
+        handle_result(result, "Failed to create timeline semaphore", ELogLvl::ERROR);
+        semaphore_          = semaphore;
+        last_claimed_value_ = initial_value;
+    }
+
+    void TimelineSemaphore::destroy() {
+        device_.destroySemaphore(semaphore_);
+        semaphore_ = nullptr;
+    }
+
+    auto TimelineSemaphore::claim_next_value() -> u64 {
+        return ++last_claimed_value_;
+    }
+
+    void TimelineSemaphore::wait(const u64 value, const u64 timeout) const {
+        const auto wait_info = vk::SemaphoreWaitInfo().setSemaphores(semaphore_).setValues(value);
+        handle_result(device_.waitSemaphores(wait_info, timeout), "Failed to wait on timeline semaphore");
+    }
+
+    auto TimelineSemaphore::is_reached(const u64 value) const -> bool {
+        return completed_value() >= value;
+    }
+
+    auto TimelineSemaphore::completed_value() const -> u64 {
+        const auto [result, value] = device_.getSemaphoreCounterValue(semaphore_);
+        handle_result(result, "Failed to query timeline semaphore value");
+        return value;
+    }
+
+    auto TimelineSemaphore::last_claimed_value() const -> u64 {
+        return last_claimed_value_;
+    }
+
+    auto TimelineSemaphore::get_handle() const -> vk::Semaphore {
+        return semaphore_;
+    }
+}  // namespace sylk
@@ -0,0 +1,287 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+#include <sylk/core/utils/all.hpp>
+#include <sylk/vulkan/utils/device_features.hpp>
+#include <sylk/vulkan/utils/result_handler.hpp>
+
+namespace sylk {
+    void DeviceFeatures::query(const vk::PhysicalDevice device) {
+        log(ELogLvl::TRACE, "Querying supported device features...");
+
+        const auto [result, dev_ext_props] = device.enumerateDeviceExtensionProperties();
+        handle_result(result, "Failed to enumerate device's extension properties");
+
+        available_extensions_.clear();
+        for (const auto& ext : dev_ext_props) {
+            available_extensions_.emplace(ext.extensionName.data());
+        }
+
+        const auto supported = device.getFeatures2<vk::PhysicalDeviceFeatures2,
+                                                   vk::PhysicalDeviceVulkan12Features,
+                                                   vk::PhysicalDeviceVulkan13Features>();
+
+        const auto& supported_vk12 = supported.get<vk::PhysicalDeviceVulkan12Features>();
+        const auto& supported_vk13 = supported.get<vk::PhysicalDeviceVulkan13Features>();
+
+        // both of these are core in 1.3, but drivers have been known to lie about their api version
+        supports_required_ = supported_vk12.timelineSemaphore && supported_vk13.synchronization2;
+        if (!supports_required_) {
+            log(ELogLvl::ERROR, "Device lacks timeline semaphore or synchronization2 support");
+        }
+
+        features_      = vk::PhysicalDeviceFeatures2 {};
+        vk12_features_ = vk::PhysicalDeviceVulkan12Features {};
+        vk13_features_ = vk::PhysicalDeviceVulkan13Features {};
+
+        vk12_features_.timelineSemaphore = true;
+        vk13_features_.synchronization2  = true;
+
+        enabled_extensions_.clear();
+        query_descriptor_indexing(supported_vk12);
+        query_draw_indirect_count(supported.get<vk::PhysicalDeviceFeatures2>().features, supported_vk12);
+        query_descriptor_buffer(device, supported_vk12);
+
+        // push descriptors have no feature struct, the extension being there is all it takes
+        supports_push_descriptor_ = has_extension(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+        if (supports_push_descriptor_) {
+            enabled_extensions_.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+        }
+
+        query_pipeline_library(device);
+        query_extended_dynamic_state3(device);
+        query_shader_object(device, supported_vk13);
+    }
+
+    void DeviceFeatures::query_pipeline_library(const vk::PhysicalDevice device) {
+        pipeline_library_features_     = vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT {};
+        supports_pipeline_library_     = false;
+        pipeline_library_fast_linking_ = false;
+
+        // the feature struct may only be chained when the extension is actually there
+        if (!has_extension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME) || !has_extension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME)) {
+            log(ELogLvl::DEBUG, "Graphics pipeline libraries unavailable, pipelines are compiled monolithically");
+            return;
+        }
+
+        const auto supported =
+            device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT>();
+        if (!supported.get<vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT>().graphicsPipelineLibrary) {
+            log(ELogLvl::DEBUG, "Graphics pipeline library extension present but feature unsupported");
+            return;
+        }
+
+        const auto properties =
+            device.getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceGraphicsPipelineLibraryPropertiesEXT>();
+
+        supports_pipeline_library_     = true;
+        pipeline_library_fast_linking_ =
+            properties.get<vk::PhysicalDeviceGraphicsPipelineLibraryPropertiesEXT>().graphicsPipelineLibraryFastLinking;
+
+        pipeline_library_features_.graphicsPipelineLibrary = true;
+        enabled_extensions_.push_back(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+        enabled_extensions_.push_back(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+
+        log(ELogLvl::DEBUG, "Graphics pipeline libraries enabled (fast linking: {})", pipeline_library_fast_linking_);
+    }
+
+    void DeviceFeatures::query_descriptor_indexing(const vk::PhysicalDeviceVulkan12Features& supported) {
+        // descriptor indexing is core in 1.2, but the parts a bindless table needs are all optional
+        supports_bindless_ = supported.runtimeDescriptorArray && supported.descriptorBindingPartiallyBound &&
+                             supported.descriptorBindingUpdateUnusedWhilePending &&
+                             supported.descriptorBindingSampledImageUpdateAfterBind &&
+                             supported.descriptorBindingStorageBufferUpdateAfterBind &&
+                             supported.shaderSampledImageArrayNonUniformIndexing &&
+                             supported.shaderStorageBufferArrayNonUniformIndexing;
+
+        if (!supports_bindless_) {
+            log(ELogLvl::DEBUG, "Descriptor indexing is incomplete, the bindless table is disabled");
+            return;
+        }
+
+        vk12_features_.runtimeDescriptorArray                        = true;
+        vk12_features_.descriptorBindingPartiallyBound               = true;
+        vk12_features_.descriptorBindingUpdateUnusedWhilePending     = true;
+        vk12_features_.descriptorBindingSampledImageUpdateAfterBind  = true;
+        vk12_features_.descriptorBindingStorageBufferUpdateAfterBind = true;
+        vk12_features_.shaderSampledImageArrayNonUniformIndexing     = true;
+        vk12_features_.shaderStorageBufferArrayNonUniformIndexing    = true;
+
+        log(ELogLvl::DEBUG, "Descriptor indexing enabled");
+    }
+
+    void DeviceFeatures::query_descriptor_buffer(const vk::PhysicalDevice device, const vk::PhysicalDeviceVulkan12Features& supported) {
+        descriptor_buffer_features_ = vk::PhysicalDeviceDescriptorBufferFeaturesEXT {};
+        supports_descriptor_buffer_ = false;
+
+        if (!has_extension(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME)) {
+            log(ELogLvl::DEBUG, "Descriptor buffers unavailable, descriptors go through pools and sets");
+            return;
+        }
+
+        const auto supported_ext =
+            device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceDescriptorBufferFeaturesEXT>();
+
+        // descriptors are written from buffer device addresses
+        if (!supported_ext.get<vk::PhysicalDeviceDescriptorBufferFeaturesEXT>().descriptorBuffer || !supported.bufferDeviceAddress) {
+            log(ELogLvl::DEBUG, "Descriptor buffer extension present but feature unsupported");
+            return;
+        }
+
+        supports_descriptor_buffer_ = true;
+
+        descriptor_buffer_features_.descriptorBuffer = true;
+        vk12_features_.bufferDeviceAddress           = true;
+        enabled_extensions_.push_back(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME);
+
+        log(ELogLvl::DEBUG, "Descriptor buffers enabled");
+    }
+
+    void DeviceFeatures::query_shader_object(const vk::PhysicalDevice device, const vk::PhysicalDeviceVulkan13Features& supported) {
+        shader_object_features_ = vk::PhysicalDeviceShaderObjectFeaturesEXT {};
+        supports_shader_object_ = false;
+
+        if (!has_extension(VK_EXT_SHADER_OBJECT_EXTENSION_NAME)) {
+            log(ELogLvl::DEBUG, "Shader objects unavailable, drawing goes through pipelines");
+            return;
+        }
+
+        const auto supported_ext =
+            device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceShaderObjectFeaturesEXT>();
+
+        // shader objects can't be used inside render pass objects, only with dynamic rendering
+        if (!supported_ext.get<vk::PhysicalDeviceShaderObjectFeaturesEXT>().shaderObject || !supported.dynamicRendering) {
+            log(ELogLvl::DEBUG, "Shader object extension present but feature unsupported");
+            return;
+        }
+
+        supports_shader_object_ = true;
+
+        shader_object_features_.shaderObject = true;
+        vk13_features_.dynamicRendering      = true;
+        enabled_extensions_.push_back(VK_EXT_SHADER_OBJECT_EXTENSION_NAME);
+
+        log(ELogLvl::DEBUG, "Shader objects enabled");
+    }
+
+    void DeviceFeatures::query_draw_indirect_count(const vk::PhysicalDeviceFeatures&         supported,
+                                                   const vk::PhysicalDeviceVulkan12Features& supported_vk12) {
+        // the culling pass writes the object index as the first instance, which is what the vertex shader looks it up by
+        supports_draw_indirect_count_ = supported_vk12.drawIndirectCount && supported.drawIndirectFirstInstance;
+
+        if (!supports_draw_indirect_count_) {
+            log(ELogLvl::DEBUG, "Indirect draw counts unavailable, the gpu scene is disabled");
+            return;
+        }
+
+        vk12_features_.drawIndirectCount             = true;
+        features_.features.drawIndirectFirstInstance = true;
+
+        log(ELogLvl::DEBUG, "Indirect draw counts enabled");
+    }
+
+    auto DeviceFeatures::supports_required() const -> bool {
+        return supports_required_;
+    }
+
+    void DeviceFeatures::query_extended_dynamic_state3(const vk::PhysicalDevice device) {
+        dynamic_state3_features_ = vk::PhysicalDeviceExtendedDynamicState3FeaturesEXT {};
+        supports_dynamic_blend_  = false;
+
+        // everything else that is dynamic is core in 1.3, blending needs the third extended dynamic state extension
+        if (!has_extension(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME)) {
+            log(ELogLvl::DEBUG, "Extended dynamic state 3 unavailable, blending is baked into pipelines");
+            return;
+        }
+
+        const auto supported =
+            device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceExtendedDynamicState3FeaturesEXT>();
+        const auto& supported_eds3 = supported.get<vk::PhysicalDeviceExtendedDynamicState3FeaturesEXT>();
+
+        if (!supported_eds3.extendedDynamicState3ColorBlendEnable || !supported_eds3.extendedDynamicState3ColorBlendEquation) {
+            log(ELogLvl::DEBUG, "Extended dynamic state 3 lacks dynamic blending, blending is baked into pipelines");
+            return;
+        }
+
+        supports_dynamic_blend_ = true;
+
+        dynamic_state3_features_.extendedDynamicState3ColorBlendEnable   = true;
+        dynamic_state3_features_.extendedDynamicState3ColorBlendEquation = true;
+        enabled_extensions_.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
+
+        log(ELogLvl::DEBUG, "Dynamic blending enabled");
+    }
+
+    auto DeviceFeatures::supports_dynamic_blend() const -> bool {
+        return supports_dynamic_blend_;
+    }
+
+    auto DeviceFeatures::supports_bindless() const -> bool {
+        return supports_bindless_;
+    }
+
+    auto DeviceFeatures::supports_descriptor_buffer() const -> bool {
+        return supports_descriptor_buffer_;
+    }
+
+    auto DeviceFeatures::supports_push_descriptor() const -> bool {
+        return supports_push_descriptor_;
+    }
+
+    auto DeviceFeatures::supports_shader_object() const -> bool {
+        return supports_shader_object_;
+    }
+
+    auto DeviceFeatures::supports_draw_indirect_count() const -> bool {
+        return supports_draw_indirect_count_;
+    }
+
+    auto DeviceFeatures::supports_pipeline_library() const -> bool {
+        return supports_pipeline_library_;
+    }
+
+    auto DeviceFeatures::pipeline_library_fast_linking() const -> bool {
+        return pipeline_library_fast_linking_;
+    }
+
+    auto DeviceFeatures::has_extension(const char* name) const -> bool {
+        return available_extensions_.contains(name);
+    }
+
+    auto DeviceFeatures::enabled_extensions() const -> std::span<const char* const> {
+        return enabled_extensions_;
+    }
+
+    auto DeviceFeatures::chain() -> const vk::PhysicalDeviceFeatures2& {
+        // re-link every time, the addresses are only stable as long as this object doesn't move
+        features_.pNext      = &vk12_features_;
+        vk12_features_.pNext = &vk13_features_;
+        // optional structs are only linked in when their extension is enabled
+        void* optional_features = nullptr;
+
+        if (supports_shader_object_) {
+            shader_object_features_.pNext = optional_features;
+            optional_features             = &shader_object_features_;
+        }
+
+        if (supports_descriptor_buffer_) {
+            descriptor_buffer_features_.pNext = optional_features;
+            optional_features                 = &descriptor_buffer_features_;
+        }
+
+        if (supports_dynamic_blend_) {
+            dynamic_state3_features_.pNext = optional_features;
+            optional_features              = &dynamic_state3_features_;
+        }
+
+        if (supports_pipeline_library_) {
+            pipeline_library_features_.pNext = optional_features;
+            optional_features                = &pipeline_library_features_;
+        }
+
+        vk13_features_.pNext = optional_features;
+
+        return features_;
+    }
+}  // namespace sylk
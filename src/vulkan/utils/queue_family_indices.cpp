@@ -28,5 +28,16 @@ auto sylk::QueueFamilyIndices::find(const vk::PhysicalDevice device, const vk::S
             break;
         }
     }
+
+    // families without graphics support are generally backed by separate hardware queues,
+    // which is what lets compute submissions actually run alongside graphics work
+    for (u32 i = 0; i < families.size(); ++i) {
+        const auto flags = families[i].queueFlags;
+        if ((flags & vk::QueueFlagBits::eCompute) && !(flags & vk::QueueFlagBits::eGraphics)) {
+            indices.compute = i;
+            break;
+        }
+    }
+
     return indices;
 }
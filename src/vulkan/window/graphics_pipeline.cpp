@@ -3,169 +3,161 @@
 //
 
 #include <sylk/core/utils/all.hpp>
+#include <sylk/shaders/instanced_vert.hpp>
+#include <sylk/shaders/instanced_vert_reflection.hpp>
+#include <sylk/shaders/shader_frag.hpp>
+#include <sylk/shaders/shader_frag_reflection.hpp>
+#include <sylk/shaders/shader_vert.hpp>
+#include <sylk/shaders/shader_vert_reflection.hpp>
+#include <sylk/vulkan/shader/instance_data.hpp>
 #include <sylk/vulkan/shader/vertex.hpp>
 #include <sylk/vulkan/utils/result_handler.hpp>
 #include <sylk/vulkan/window/graphics_pipeline.hpp>
 
-constexpr const char* DEFAULT_SHADER_ENTRY_NAME = "main";
+static_assert(sizeof(sylk::Vertex) == sylk::SHADER_VERT_REFLECTION.vertex_stride, "Vertex no longer matches the inputs of shader.vert");
+static_assert(sylk::SHADER_VERT_REFLECTION.push_constants.size() == 1 &&
+                  sizeof(sylk::DrawConstants) == sylk::SHADER_VERT_REFLECTION.push_constants[0].size,
+              "DrawConstants no longer matches the push constants of shader.vert");
+static_assert(sizeof(sylk::Vertex) == sylk::INSTANCED_VERT_REFLECTION.vertex_stride &&
+                  sizeof(sylk::InstanceData) == sylk::INSTANCED_VERT_REFLECTION.instance_stride,
+              "Vertex or InstanceData no longer match the inputs of instanced.vert");
 
 namespace sylk {
-    void GraphicsPipeline::create(const vk::Extent2D extent, const vk::RenderPass renderpass) {
-        vertex_shader_.create("../../shaders/vert.spv");
-        fragment_shader_.create("../../shaders/frag.spv");
-
-        const auto vert_stage_info = vk::PipelineShaderStageCreateInfo {
-            .stage  = vk::ShaderStageFlagBits::eVertex,
-            .module = vertex_shader_.get_module(),
-            .pName  = DEFAULT_SHADER_ENTRY_NAME,
-        };
+    void GraphicsPipeline::create(const vk::RenderPass renderpass, PipelineLibrary& library, PipelineLayoutCache& layouts) {
+        describe(renderpass, layouts);
 
-        const auto frag_stage_info = vk::PipelineShaderStageCreateInfo {
-            .stage  = vk::ShaderStageFlagBits::eFragment,
-            .module = fragment_shader_.get_module(),
-            .pName  = DEFAULT_SHADER_ENTRY_NAME,
-        };
+        // this is the fallback for every other pipeline, so it has to exist before the first frame
+        default_handle_ = library.request_blocking(base_desc_);
 
-        const std::array shader_stages = {
-            vert_stage_info,
-            frag_stage_info,
-        };
+        if (!library.resolve(default_handle_)) {
+            log(ELogLvl::CRITICAL, "Failed to create default graphics pipeline");
+        }
 
-        const std::vector<vk::DynamicState> dynamic_states = {
-            vk::DynamicState::eViewport,
-            vk::DynamicState::eScissor,
-        };
+        // instanced draws are skipped until this one is ready, which is never long after the default one
+        instanced_handle_ = library.request(instanced_desc_);
 
-        const auto dynamic_state_info = vk::PipelineDynamicStateCreateInfo().setDynamicStates(dynamic_states);
+        log(ELogLvl::DEBUG, "Created graphics pipeline");
+    }
 
-        const auto vertex_attribute_descs  = Vertex::attribute_descriptions();
-        const auto vertex_binding_desc     = Vertex::binding_description();
-        const auto vertex_input_state_info = vk::PipelineVertexInputStateCreateInfo()
-                                                 .setVertexAttributeDescriptions(vertex_attribute_descs)
-                                                 .setVertexBindingDescriptions(vertex_binding_desc);
+    void GraphicsPipeline::create(ShaderObjectCache& shader_objects, PipelineLayoutCache& layouts) {
+        // shader objects only work with dynamic rendering, there is no renderpass to build against
+        describe(nullptr, layouts);
 
-        const auto input_assembly_state_info = vk::PipelineInputAssemblyStateCreateInfo {
-            .topology               = vk::PrimitiveTopology::eTriangleList,
-            .primitiveRestartEnable = false,
-        };
+        default_handle_ = shader_objects.request(base_desc_);
 
-        const auto viewport = vk::Viewport {
-            .width    = cast<f32>(extent.width),
-            .height   = cast<f32>(extent.height),
-            .maxDepth = 1.0f,
-        };
+        instanced_handle_ = shader_objects.request(instanced_desc_);
 
-        const auto scissor = vk::Rect2D {.extent = extent};
+        if (!default_handle_ || !instanced_handle_) {
+            log(ELogLvl::CRITICAL, "Failed to create default shader objects");
+        }
 
-        const auto viewport_state_info = vk::PipelineViewportStateCreateInfo().setViewports(viewport).setScissors(scissor);
+        log(ELogLvl::DEBUG, "Created graphics shader objects");
+    }
 
-        const auto rasterizer_info = vk::PipelineRasterizationStateCreateInfo {
-            .depthClampEnable        = false,
-            .rasterizerDiscardEnable = false,
-            .polygonMode             = vk::PolygonMode::eFill,
-            .cullMode                = vk::CullModeFlagBits::eNone,
-            .frontFace               = vk::FrontFace::eCounterClockwise,
-            .depthBiasEnable         = false,
-            .lineWidth               = 1.0f,
+    void GraphicsPipeline::describe(const vk::RenderPass renderpass, PipelineLayoutCache& layouts) {
+        vertex_shader_.create(SHADER_VERT);
+        instanced_vertex_shader_.create(INSTANCED_VERT);
+        fragment_shader_.create(SHADER_FRAG);
+
+        const std::array stages = {&SHADER_VERT_REFLECTION, &SHADER_FRAG_REFLECTION};
+        const auto&      layout = layouts.get(stages);
+
+        cached_layout_         = &layout;
+        layout_                = layout.pipeline_layout;
+        descriptor_set_layout_ = layout.set_layouts.at(0);
+        draw_constants_        = PushConstants<DrawConstants>(layout_, layout.push_constant_ranges);
+
+        base_desc_ = PipelineDesc {
+            .vertex_shader     = vertex_shader_.get_module(),
+            .fragment_shader   = fragment_shader_.get_module(),
+            .layout            = layout_,
+            .renderpass        = renderpass,
+            .subpass           = 0,
+            .vertex_bindings   = vertex_binding_descriptions(SHADER_VERT_REFLECTION),
+            .vertex_attributes = vertex_attribute_descriptions(SHADER_VERT_REFLECTION),
+            .state             = RenderState {},
         };
 
-        const auto multisampling_info = vk::PipelineMultisampleStateCreateInfo {
-            .rasterizationSamples = vk::SampleCountFlagBits::e1,
-            .sampleShadingEnable  = false,
-        };
+        // draws switch between both without rebinding anything, so the layouts have to be one and the same
+        const std::array instanced_stages = {&INSTANCED_VERT_REFLECTION, &SHADER_FRAG_REFLECTION};
+        if (layouts.get(instanced_stages).pipeline_layout != layout_) {
+            log(ELogLvl::ERROR, "instanced.vert no longer agrees with shader.vert on its bindings and push constants");
+        }
 
-        const auto color_blend_attachment = vk::PipelineColorBlendAttachmentState {
-            .blendEnable         = true,
-            .srcColorBlendFactor = vk::BlendFactor::eSrcAlpha,
-            .dstColorBlendFactor = vk::BlendFactor::eOneMinusSrcAlpha,
-            .colorBlendOp        = vk::BlendOp::eAdd,
-            .srcAlphaBlendFactor = vk::BlendFactor::eOne,
-            .dstAlphaBlendFactor = vk::BlendFactor::eZero,
-            .alphaBlendOp        = vk::BlendOp::eAdd,
-            .colorWriteMask = vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG | vk::ColorComponentFlagBits::eB |
-                              vk::ColorComponentFlagBits::eA,
-        };
+        instanced_desc_                   = base_desc_;
+        instanced_desc_.vertex_shader     = instanced_vertex_shader_.get_module();
+        instanced_desc_.vertex_bindings   = vertex_binding_descriptions(INSTANCED_VERT_REFLECTION);
+        instanced_desc_.vertex_attributes = vertex_attribute_descriptions(INSTANCED_VERT_REFLECTION);
+    }
 
-        const auto color_blend_info =
-            vk::PipelineColorBlendStateCreateInfo {
-                .logicOpEnable = false,
-            }
-                .setAttachments(color_blend_attachment);
-
-        create_descriptorset_layout();
-
-        const auto layout_info             = vk::PipelineLayoutCreateInfo().setSetLayouts(descriptor_set_layout_);
-        const auto [layout_result, layout] = device_.createPipelineLayout(layout_info);
-        handle_result(layout_result, "Failed to create pipeline layout", ELogLvl::ERROR);
-        layout_ = layout;
-
-        const auto pipeline_info =
-            vk::GraphicsPipelineCreateInfo {
-                .pVertexInputState   = &vertex_input_state_info,
-                .pInputAssemblyState = &input_assembly_state_info,
-                .pViewportState      = &viewport_state_info,
-                .pRasterizationState = &rasterizer_info,
-                .pMultisampleState   = &multisampling_info,
-                .pColorBlendState    = &color_blend_info,
-                .pDynamicState       = &dynamic_state_info,
-                .layout              = layout_,
-                .renderPass          = renderpass,
-                .subpass             = 0,
-            }
-                .setStages(shader_stages);
-
-        const auto [result, pipeline] = device_.createGraphicsPipeline(nullptr, pipeline_info);
-        handle_result(result, "Failed to create graphics pipeline", ELogLvl::CRITICAL);
-        pipeline_ = pipeline;
+    GraphicsPipeline::GraphicsPipeline(const vk::Device& device, ShaderModuleCache& shader_modules)
+        : device_(device)
+        , vertex_shader_(shader_modules)
+        , instanced_vertex_shader_(shader_modules)
+        , fragment_shader_(shader_modules) {}
 
+    void GraphicsPipeline::destroy() {
+        // the pipeline belongs to the library and the layouts to the layout cache
+        // the shaders have to outlive any compile still in flight, the cache destroys the modules once nothing uses them
         vertex_shader_.destroy();
+        instanced_vertex_shader_.destroy();
         fragment_shader_.destroy();
-
-        log(ELogLvl::DEBUG, "Created graphics pipeline");
     }
 
-    GraphicsPipeline::GraphicsPipeline(const vk::Device& device)
-        : device_(device)
-        , fragment_shader_(device)
-        , vertex_shader_(device) {}
-
-    void GraphicsPipeline::destroy() const {
-        device_.destroyPipeline(pipeline_);
-        log(ELogLvl::TRACE, "Destroyed graphics pipeline");
+    auto GraphicsPipeline::reload_shader(const std::string_view source_name, const std::span<const u32> code)
+        -> std::pair<vk::ShaderModule, vk::ShaderModule> {
+        // the interface can't change without the layout and vertex input changing as well, which the build has to redo
+        if (source_name == "shader.vert") {
+            const auto replaced      = vertex_shader_.reload(code);
+            base_desc_.vertex_shader = vertex_shader_.get_module();
+            return {replaced, (replaced ? base_desc_.vertex_shader : nullptr)};
+        }
+
+        if (source_name == "instanced.vert") {
+            const auto replaced           = instanced_vertex_shader_.reload(code);
+            instanced_desc_.vertex_shader = instanced_vertex_shader_.get_module();
+            return {replaced, (replaced ? instanced_desc_.vertex_shader : nullptr)};
+        }
+
+        if (source_name == "shader.frag") {
+            const auto replaced             = fragment_shader_.reload(code);
+            base_desc_.fragment_shader      = fragment_shader_.get_module();
+            instanced_desc_.fragment_shader = base_desc_.fragment_shader;
+            return {replaced, (replaced ? base_desc_.fragment_shader : nullptr)};
+        }
+
+        return {};
+    }
 
-        device_.destroyPipelineLayout(layout_);
-        log(ELogLvl::TRACE, "Destroyed graphics pipeline layout");
+    auto GraphicsPipeline::get_descriptor_set_layout() const -> vk::DescriptorSetLayout {
+        return descriptor_set_layout_;
     }
 
-    auto GraphicsPipeline::get_handle() const -> vk::Pipeline {
-        return pipeline_;
+    auto GraphicsPipeline::cached_layout() const -> const PipelineLayoutCache::Layout& {
+        return *cached_layout_;
     }
 
-    void GraphicsPipeline::create_descriptorset_layout() {
-        const auto ubo_layout_binding = vk::DescriptorSetLayoutBinding {
-            .binding         = 0,
-            .descriptorType  = vk::DescriptorType::eUniformBuffer,
-            .descriptorCount = 1,
-            .stageFlags      = vk::ShaderStageFlagBits::eVertex,
-        };
+    auto GraphicsPipeline::get_layout() const -> vk::PipelineLayout {
+        return layout_;
+    }
 
-        const auto layout_info = vk::DescriptorSetLayoutCreateInfo().setBindings(ubo_layout_binding);
+    auto GraphicsPipeline::draw_constants() const -> const PushConstants<DrawConstants>& {
+        return draw_constants_;
+    }
 
-        const auto [result, layout] = device_.createDescriptorSetLayout(layout_info);
-        handle_result(result, "Failed to create uniform buffer descriptor set layout");
-        descriptor_set_layout_ = layout;
+    auto GraphicsPipeline::default_handle() const -> PipelineHandle {
+        return default_handle_;
     }
 
-    void GraphicsPipeline::destroy_descriptorset_layouts() {
-        device_.destroyDescriptorSetLayout(descriptor_set_layout_);
-        log(ELogLvl::TRACE, "Destroyed descriptor set layouts");
+    auto GraphicsPipeline::base_desc() const -> const PipelineDesc& {
+        return base_desc_;
     }
 
-    auto GraphicsPipeline::get_descriptor_set_layout() const -> vk::DescriptorSetLayout {
-        return descriptor_set_layout_;
+    auto GraphicsPipeline::instanced_handle() const -> PipelineHandle {
+        return instanced_handle_;
     }
 
-    auto GraphicsPipeline::get_layout() const -> vk::PipelineLayout {
-        return layout_;
+    auto GraphicsPipeline::instanced_desc() const -> const PipelineDesc& {
+        return instanced_desc_;
     }
 }  // namespace sylk
\ No newline at end of file
@@ -3,7 +3,9 @@
 //
 
 #include <sylk/core/utils/all.hpp>
+#include <sylk/core/utils/radix_sort.hpp>
 #include <sylk/vulkan/shader/uniformbuffer.hpp>
+#include <sylk/vulkan/utils/constants.hpp>
 #include <sylk/vulkan/utils/queue_family_indices.hpp>
 #include <sylk/vulkan/utils/result_handler.hpp>
 #include <sylk/vulkan/vulkan.hpp>
@@ -13,26 +15,110 @@
 
 #define GLM_FORCE_RADIANS
 #include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <limits>
+#include <tuple>
 
 constexpr sylk::u32 U32_LIMIT            = std::numeric_limits<sylk::u32>::max();
 constexpr sylk::i32 MAX_FRAMES_IN_FLIGHT = 3;
 
+// the built-in sprite atlas, pages of square cells with a soft disc in each
+constexpr sylk::u32 SPRITE_ATLAS_PAGES     = 2;
+constexpr sylk::u32 SPRITE_ATLAS_PAGE_SIZE = 256;
+constexpr sylk::u32 SPRITE_ATLAS_CELL_SIZE = 64;
+
+// the gpu scene benchmark scatters its objects over a square this many units across each way from the origin
+constexpr sylk::f32 GPU_SCENE_BENCHMARK_EXTENT = 16.0f;
+
+namespace {
+    // set 0 of shader.vert, packed for its descriptor template
+    struct FrameDescriptors {
+        vk::DescriptorBufferInfo uniforms;
+    };
+
+    // rgba8 texels of one atlas page, every cell gets a hue of its own so batches are easy to tell apart on screen
+    auto sprite_page_texels(const sylk::u32 page) -> std::vector<sylk::u32> {
+        using namespace sylk;
+
+        constexpr u32 cells_per_row = SPRITE_ATLAS_PAGE_SIZE / SPRITE_ATLAS_CELL_SIZE;
+        constexpr f32 radius        = SPRITE_ATLAS_CELL_SIZE * 0.5f - 2.0f;
+
+        std::vector<u32> texels(SPRITE_ATLAS_PAGE_SIZE * SPRITE_ATLAS_PAGE_SIZE);
+        for (u32 y = 0; y < SPRITE_ATLAS_PAGE_SIZE; ++y) {
+            for (u32 x = 0; x < SPRITE_ATLAS_PAGE_SIZE; ++x) {
+                const u32 cell = (y / SPRITE_ATLAS_CELL_SIZE) * cells_per_row + x / SPRITE_ATLAS_CELL_SIZE;
+                const f32 hue  = cast<f32>(page * cells_per_row * cells_per_row + cell) / (SPRITE_ATLAS_PAGES * cells_per_row * cells_per_row);
+
+                const f32 dx = cast<f32>(x % SPRITE_ATLAS_CELL_SIZE) + 0.5f - SPRITE_ATLAS_CELL_SIZE * 0.5f;
+                const f32 dy = cast<f32>(y % SPRITE_ATLAS_CELL_SIZE) + 0.5f - SPRITE_ATLAS_CELL_SIZE * 0.5f;
+
+                // the colour is kept outside the disc as well, so filtering never pulls black into the edge
+                const auto color = glm::vec4 {0.5f + 0.5f * std::cos(glm::two_pi<f32>() * hue),
+                                              0.5f + 0.5f * std::cos(glm::two_pi<f32>() * (hue + 1.0f / 3.0f)),
+                                              0.5f + 0.5f * std::cos(glm::two_pi<f32>() * (hue + 2.0f / 3.0f)),
+                                              std::clamp(radius - std::sqrt(dx * dx + dy * dy), 0.0f, 1.0f)};
+
+                texels[y * SPRITE_ATLAS_PAGE_SIZE + x] = glm::packUnorm4x8(color);
+            }
+        }
+
+        return texels;
+    }
+
+    // a cheap integer hash, scatters benchmark sprites the same way on every run without keeping any state around
+    auto scatter(sylk::u32 value) -> sylk::u32 {
+        value ^= value >> 16;
+        value *= 0x7FEB352Du;
+        value ^= value >> 15;
+        value *= 0x846CA68Bu;
+        value ^= value >> 16;
+        return value;
+    }
+
+    // [0, 1] out of the low 24 bits
+    auto unit(const sylk::u32 value) -> sylk::f32 {
+        return sylk::cast<sylk::f32>(value & 0xFFFFFFu) / sylk::cast<sylk::f32>(0xFFFFFFu);
+    }
+
+    // keeps sprites that leave one edge of the window coming back in at the other
+    auto wrap(const sylk::f32 value, const sylk::f32 range) -> sylk::f32 {
+        const auto wrapped = std::fmod(value, range);
+        return (wrapped < 0.0f ? wrapped + range : wrapped);
+    }
+}  // namespace
+
 namespace sylk {
     Swapchain::Swapchain(const vk::Device& device)
         : current_frame_(0)
         , device_(device)
-        , graphics_pipeline_(device)
-        , command_buffers_(MAX_FRAMES_IN_FLIGHT)
+        , pipeline_cache_(device)
+        , pipeline_library_(device)
+        , pipeline_layouts_(device)
+        , shader_modules_(device)
+        , shader_objects_(device, shader_modules_, pipeline_layouts_)
+        , graphics_pipeline_(device, shader_modules_)
+        , graphics_queue_(device)
+        , compute_queue_(device)
+        , descriptor_allocator_(device)
+        , descriptor_buffer_(device)
+        , bindless_table_(device)
+        , command_allocator_(device)
         , semaphores_img_available_(MAX_FRAMES_IN_FLIGHT)
         , semaphores_render_finished_(MAX_FRAMES_IN_FLIGHT)
         , fences_in_flight_(MAX_FRAMES_IN_FLIGHT)
         , uniform_buffers_(MAX_FRAMES_IN_FLIGHT)
-        , descriptor_sets_(MAX_FRAMES_IN_FLIGHT) {}
+        , instance_stream_(device)
+        , sprite_batch_(device, shader_modules_)
+        , gpu_scene_(device, shader_modules_)
+        , descriptor_sets_(MAX_FRAMES_IN_FLIGHT)
+        , frame_descriptors_(MAX_FRAMES_IN_FLIGHT)
+        , frame_descriptor_template_(device) {}
 
     void Swapchain::create(const vk::PhysicalDevice physical_device, GLFWwindow* window, const vk::SurfaceKHR surface) {
         log(ELogLvl::TRACE, "Creating swapchain...");
@@ -41,26 +127,52 @@ namespace sylk {
         window_          = window;
         surface_         = surface;
 
+        // shader objects render with dynamic rendering, so there is neither a renderpass nor framebuffers in that case
+        use_shader_objects_ = prefer_shader_objects_ && device_features_->supports_shader_object();
+        if (prefer_shader_objects_ && !use_shader_objects_) {
+            log(ELogLvl::WARN, "Device lacks shader object support, falling back to pipelines");
+        }
+
         setup_swapchain();
         create_image_views();
-        create_renderpass();
-        graphics_pipeline_.create(extent_, renderpass_);
+        if (!use_shader_objects_) {
+            create_renderpass();
+        }
+        pipeline_cache_.create(physical_device_, PIPELINE_CACHE_PATH);
+        pipeline_library_.create(pipeline_cache_.get_handle(), PIPELINE_COMPILE_WORKERS, MAX_FRAMES_IN_FLIGHT, *device_features_);
+        create_descriptor_backend();
+        create_bindless_table();
+        if (use_shader_objects_) {
+            graphics_pipeline_.create(shader_objects_, pipeline_layouts_);
+        } else {
+            graphics_pipeline_.create(renderpass_, pipeline_library_, pipeline_layouts_);
+        }
+        create_sprite_batch();
+        create_gpu_scene();
         create_framebuffers();
-        create_command_pool();
-        create_staged_buffer(vertex_buffer_, vk::BufferUsageFlagBits::eVertexBuffer, vertices_);
-        create_staged_buffer(index_buffer_, vk::BufferUsageFlagBits::eIndexBuffer, indices_);
+        create_command_allocator();
+        upload_static_geometry();
         create_uniform_buffers();
-        create_descriptor_pool();
+        create_instance_stream();
         create_descriptor_sets();
-        create_command_buffer();
         create_synchronizers();
 
+#ifdef SYLK_SHADER_HOT_RELOAD
+        shader_hot_reload_.create();
+#endif
+
+        start_time_      = std::chrono::steady_clock::now();
+        last_frame_time_ = start_time_;
+
         log(ELogLvl::DEBUG, "Created swapchain");
     }
 
     void Swapchain::destroy() {
-        device_.destroyCommandPool(command_pool_);
-        log(ELogLvl::TRACE, "Destroyed command pool");
+#ifdef SYLK_SHADER_HOT_RELOAD
+        shader_hot_reload_.destroy();
+#endif
+
+        command_allocator_.destroy();
 
         vertex_buffer_.destroy_with(device_);
         log(ELogLvl::TRACE, "Destroyed vertex buffer");
@@ -73,11 +185,41 @@ namespace sylk {
         }
         log(ELogLvl::TRACE, "Destroyed uniform buffers");
 
-        device_.destroyDescriptorPool(descriptor_pool_);
-        log(ELogLvl::TRACE, "Destroyed descriptor pool");
+        instance_stream_.destroy();
+
+        if (sprite_batch_.valid()) {
+            sprite_batch_.destroy();
+        }
+
+        for (auto& page : sprite_pages_) {
+            page.destroy_with(device_);
+        }
+        sprite_pages_.clear();
 
+        if (gpu_scene_.valid()) {
+            gpu_scene_.destroy();
+        }
+
+        if (bindless_table_.valid()) {
+            bindless_table_.destroy();
+        }
+
+        if (frame_descriptor_template_.valid()) {
+            frame_descriptor_template_.destroy();
+        }
+
+        if (descriptor_buffer_.valid()) {
+            descriptor_buffer_.destroy();
+        } else {
+            descriptor_allocator_.destroy();
+        }
+
+        pipeline_library_.destroy();
+        shader_objects_.destroy();
         graphics_pipeline_.destroy();
-        graphics_pipeline_.destroy_descriptorset_layouts();
+        shader_modules_.destroy();
+        pipeline_layouts_.destroy();
+        pipeline_cache_.destroy();
 
         device_.destroyRenderPass(renderpass_);
         log(ELogLvl::TRACE, "Destroyed renderpass");
@@ -89,6 +231,12 @@ namespace sylk {
         }
         log(ELogLvl::TRACE, "Destroyed synchronization objects");
 
+        graphics_queue_.destroy();
+        if (!compute_shares_graphics_) {
+            compute_queue_.destroy();
+        }
+        log(ELogLvl::TRACE, "Destroyed queue timelines");
+
         destroy_partial();
     }
 
@@ -194,6 +342,11 @@ namespace sylk {
     }
 
     void Swapchain::create_framebuffers() {
+        // dynamic rendering renders straight into the image views
+        if (use_shader_objects_) {
+            return;
+        }
+
         frame_buffers_.resize(image_views_.size());
 
         for (u64 i = 0; i < image_views_.size(); ++i) {
@@ -235,6 +388,89 @@ namespace sylk {
     }
 
     void Swapchain::draw_next() {
+        if (gpu_scene_benchmark_ > 0 && gpu_scene_.valid()) {
+            simulate([this](FramePacket& packet) { simulate_gpu_scene_benchmark(packet); });
+        } else if (sprite_benchmark_ > 0) {
+            simulate([this](FramePacket& packet) { simulate_sprite_benchmark(packet); });
+        } else {
+            simulate([this](FramePacket& packet) { simulate_default_scene(packet); });
+        }
+        build_draw_list();
+        record_and_submit();
+    }
+
+    void Swapchain::simulate(const SimulateCallback& callback) {
+        namespace clock = std::chrono;
+
+        const auto current_time = clock::steady_clock::now();
+
+        ++frame_packet_.frame_number;
+        frame_packet_.delta_time   = clock::duration<f32, clock::seconds::period>(current_time - last_frame_time_).count();
+        frame_packet_.elapsed_time = clock::duration<f32, clock::seconds::period>(current_time - start_time_).count();
+        frame_packet_.draws.clear();
+        frame_packet_.instances.clear();
+        frame_packet_.sprites.clear();
+        last_frame_time_ = current_time;
+
+        callback(frame_packet_);
+    }
+
+    void Swapchain::build_draw_list() {
+        // swapping rather than copying keeps both vectors' capacity around for the next frame
+        draw_list_.clear();
+        draw_list_.swap(frame_packet_.draws);
+        instance_list_.clear();
+        instance_list_.swap(frame_packet_.instances);
+
+        std::erase_if(draw_list_, [this](const DrawCommand& draw) {
+            if (draw.instanced && cast<u64>(draw.first_instance) + draw.instance_count > instance_list_.size()) {
+                log(ELogLvl::ERROR, "Instanced draw reads past the {} instance(s) of the frame", instance_list_.size());
+                return true;
+            }
+
+            return draw.index_count == 0 || draw.instance_count == 0;
+        });
+
+        // sorting only touches cpu memory, the instances are written once the frame slot is free again
+        if (sprite_batch_.valid()) {
+            sprite_batch_.build(frame_packet_.sprites);
+        } else if (!frame_packet_.sprites.empty()) {
+            log(ELogLvl::WARN, "Dropping {} sprite(s), sprites need a bindless table", frame_packet_.sprites.size());
+        }
+
+        scene_view_projection_ = frame_packet_.scene_view_projection;
+
+        // nothing was requested, so fall back to the built-in quad to keep something on screen
+        if (draw_list_.empty() && sprite_batch_.empty() && gpu_scene_.empty()) {
+            draw_list_.push_back({.index_count = cast<u32>(indices_.size())});
+        }
+
+        // keys are built from the pipeline the draw will actually bind, so draws left on a default group with it
+        draw_packets_.clear();
+        draw_packets_.reserve(draw_list_.size());
+        for (u32 i = 0; i < draw_list_.size(); ++i) {
+            const auto& draw        = draw_list_[i];
+            const auto  base_handle = (draw.instanced ? graphics_pipeline_.instanced_handle() : graphics_pipeline_.default_handle());
+
+            const auto key = make_draw_key({
+                .pass     = draw.pass,
+                .layer    = draw.layer,
+                .pipeline = (draw.pipeline ? draw.pipeline : base_handle),
+                .material = draw.constants.material_index,
+                .depth    = draw.depth,
+            });
+
+            draw_packets_.push_back({.key = key, .payload = i});
+        }
+
+        draw_packet_scratch_.resize(draw_packets_.size());
+        radix_sort(std::span<DrawPacket>(draw_packets_),
+                   std::span<DrawPacket>(draw_packet_scratch_),
+                   [](const DrawPacket& packet) { return packet.key; },
+                   SORT_THREADS);
+    }
+
+    void Swapchain::record_and_submit() {
         handle_result(device_.waitForFences(fences_in_flight_[current_frame_], true, UINT64_MAX), "Vulkan fence error");
 
         const auto [result,
@@ -247,21 +483,56 @@ namespace sylk {
         }
 
         device_.resetFences(fences_in_flight_[current_frame_]);
-        command_buffers_[current_frame_].reset();
-        record_command_buffer(command_buffers_[current_frame_], img_index);
 
-        const vk::PipelineStageFlags wait_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+        // the fence guarantees the gpu is done reading this slot's uniform buffer
+        uniform_buffers_[current_frame_].pass_data(&frame_packet_.ubo, sizeof(UniformBufferObject));
+
+        // the fence also covers every command buffer and descriptor set handed out for this slot last time around
+        command_allocator_.begin_frame(current_frame_);
+        instance_stream_.begin_frame(current_frame_);
+        pipeline_library_.begin_frame();
+        if (sprite_batch_.valid()) {
+            sprite_batch_.begin_frame(current_frame_);
+        }
+        if (gpu_scene_.valid()) {
+            gpu_scene_.begin_frame(current_frame_);
+        }
+        if (descriptor_buffer_.valid()) {
+            descriptor_buffer_.begin_frame(current_frame_);
+        } else {
+            descriptor_allocator_.begin_frame(current_frame_);
+        }
+
+#ifdef SYLK_SHADER_HOT_RELOAD
+        apply_shader_reloads();
+#endif
+
+        // update after bind would allow this during recording too, but one batch per frame is cheaper
+        if (bindless_table_.valid()) {
+            bindless_table_.begin_frame(current_frame_);
+            bindless_table_.flush();
+        }
+        const auto cmd_buffer = command_allocator_.allocate();
+        record_command_buffer(cmd_buffer, img_index);
 
-        const auto submit_info = vk::SubmitInfo()
-                                     .setWaitSemaphores(semaphores_img_available_[current_frame_])
-                                     .setWaitDstStageMask(wait_stage)
-                                     .setSignalSemaphores(semaphores_render_finished_[current_frame_])
-                                     .setCommandBuffers(command_buffers_[current_frame_]);
+        const auto wait = Queue::SemaphoreDependency {
+            .semaphore = semaphores_img_available_[current_frame_],
+            .stages    = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+        };
 
-        update_uniform_buffers();
+        const auto signal = Queue::SemaphoreDependency {
+            .semaphore = semaphores_render_finished_[current_frame_],
+            .stages    = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+        };
 
-        handle_result(graphics_queue_.submit(submit_info, fences_in_flight_[current_frame_]),
-                      "Failed to submit to graphics queue");
+        submit_batcher_.add(graphics_queue_,
+                            {
+                                .command_buffers = {&cmd_buffer, 1},
+                                .waits           = {&wait, 1},
+                                .signals         = {&signal, 1},
+                                .fence           = fences_in_flight_[current_frame_],
+                            });
+        submit_batcher_.flush();
 
         const auto present_info = vk::PresentInfoKHR()
                                       .setWaitSemaphores(semaphores_render_finished_[current_frame_])
@@ -275,6 +546,11 @@ namespace sylk {
             handle_result(present_result, "Failed to present image");
         }
 
+        submit_batcher_.end_frame();
+        if (pipeline_cache_.save_due(std::chrono::seconds(PIPELINE_CACHE_SAVE_INTERVAL_SECONDS))) {
+            pipeline_library_.save_cache(pipeline_cache_);
+        }
+
         current_frame_ = ++current_frame_ % MAX_FRAMES_IN_FLIGHT;
     }
 
@@ -282,68 +558,251 @@ namespace sylk {
         const auto buffer_begin_info = vk::CommandBufferBeginInfo();
         handle_result(buffer.begin(buffer_begin_info), "Failed to start recording command buffer");
 
-        const auto clear_color = vk::ClearValue {.color = {std::array {0.0f, 0.0f, 0.0f, 1.0f}}};
-        const auto renderpass_begin_info =
-            vk::RenderPassBeginInfo {
-                .renderPass  = renderpass_,
-                .framebuffer = frame_buffers_[image_index],
-                .renderArea  = vk::Rect2D {.extent = extent_},
+        // blending is always dynamic with shader objects
+        auto& encoder = command_encoder_;
+        encoder.begin(buffer, use_shader_objects_ || pipeline_library_.dynamic_blend());
+
+        // a pipeline that became ready or was swapped meanwhile is picked up with the next frame
+        resolved_pipelines_.clear();
+
+        // bound once for the whole command buffer, the culling pass reads its sets from it as well
+        if (descriptor_buffer_.valid()) {
+            descriptor_buffer_.bind(buffer);
+        }
+
+        // culling is a compute pass, so it goes before rendering begins
+        if (gpu_scene_.valid()) {
+            gpu_scene_.cull(encoder, scene_view_projection_);
+        }
+
+        begin_rendering(buffer, image_index);
 
+        encoder.bind_vertex_buffer(VERTEX_BINDING, vertex_buffer_.vk_buffer());
+        encoder.bind_index_buffer(index_buffer_.vk_buffer(), 0, vk::IndexType::eUint16);
+
+        // pipelines without per instance inputs ignore the binding, so it's bound once for every draw that needs it
+        bool instances_bound = false;
+        if (!instance_list_.empty()) {
+            if (const auto instances = instance_stream_.write(std::span<const InstanceData>(instance_list_))) {
+                encoder.bind_vertex_buffer(INSTANCE_BINDING, instance_stream_.vk_buffer(), instances.offset);
+                instances_bound = true;
             }
-                .setClearValues(clear_color);
+        }
 
-        buffer.beginRenderPass(renderpass_begin_info, vk::SubpassContents::eInline);
-        buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, graphics_pipeline_.get_handle());
+        if (use_shader_objects_) {
+            ShaderObjectCache::set_fixed_state(buffer, extent_);
+        } else {
+            encoder.set_viewport(vk::Viewport {
+                .width    = cast<f32>(extent_.width),
+                .height   = cast<f32>(extent_.height),
+                .maxDepth = 1.0f,
+            });
 
-        buffer.bindVertexBuffers(0, vertex_buffer_.vk_buffer(), vk::DeviceSize {0});
-        buffer.bindIndexBuffer(index_buffer_.vk_buffer(), vk::DeviceSize {0}, vk::IndexType::eUint16);
+            encoder.set_scissor(vk::Rect2D {.extent = extent_});
+        }
 
-        buffer.setViewport(0,
-                           vk::Viewport {
-                               .width    = cast<f32>(extent_.width),
-                               .height   = cast<f32>(extent_.height),
-                               .maxDepth = 1.0f,
-                           });
+        // pushed sets and descriptor buffer offsets aren't binds the encoder could skip, they're recorded once a frame
+        if (descriptor_buffer_.valid()) {
+            descriptor_buffer_.set_offset(buffer,
+                                          vk::PipelineBindPoint::eGraphics,
+                                          graphics_pipeline_.get_layout(),
+                                          0,
+                                          frame_descriptors_[current_frame_]);
+        } else if (push_frame_descriptors_) {
+            frame_descriptor_template_.push(buffer,
+                                            FrameDescriptors {
+                                                .uniforms = {.buffer = uniform_buffers_[current_frame_].vk_buffer(),
+                                                             .offset = 0,
+                                                             .range  = sizeof(UniformBufferObject)},
+                                            });
+        } else {
+            encoder.bind_descriptor_set(vk::PipelineBindPoint::eGraphics,
+                                        graphics_pipeline_.get_layout(),
+                                        0,
+                                        descriptor_sets_[current_frame_]);
+        }
 
-        buffer.setScissor(0, vk::Rect2D {.extent = extent_});
+        if (bindless_table_.valid()) {
+            bindless_table_.bind(buffer, vk::PipelineBindPoint::eGraphics, graphics_pipeline_.get_layout());
+        }
 
-        buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                                  graphics_pipeline_.get_layout(),
-                                  0,
-                                  descriptor_sets_[current_frame_],
-                                  nullptr);
+        // every variant shares the default pipeline's layout, so the descriptor sets and push constants stay compatible
+        // across pipeline switches, the encoder drops every bind of a pipeline that's bound already
+        for (const auto& packet : draw_packets_) {
+            const auto& draw = draw_list_[packet.payload];
 
-        buffer.drawIndexed(cast<u32>(indices_.size()), 1, 0, 0, 0);
+            if (draw.instanced && !instances_bound) {
+                continue;
+            }
 
-        buffer.endRenderPass();
+            const auto base_handle = (draw.instanced ? graphics_pipeline_.instanced_handle() : graphics_pipeline_.default_handle());
+
+            if (use_shader_objects_) {
+                // programs are compiled as they're requested, there's never one that isn't ready yet
+                const auto* program = shader_objects_.resolve(draw.pipeline, base_handle);
+
+                if (!program) {
+                    continue;
+                }
+
+                encoder.bind_program(*program);
+            } else {
+                // the defaults are resolved every frame as well, so their optimized link is bound as soon as it's swapped in
+                // the instanced default is compiled in the background, so unlike the default it may not be ready yet
+                auto pipeline = resolve_pipeline(draw.pipeline ? draw.pipeline : base_handle);
+                if (!pipeline && !draw.skip_until_ready) {
+                    pipeline = resolve_pipeline(base_handle);
+                }
+
+                if (!pipeline) {
+                    continue;
+                }
+
+                encoder.bind_pipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+            }
+
+            encoder.set_render_state(draw.state);
+            graphics_pipeline_.draw_constants().push(buffer, draw.constants);
+            buffer.drawIndexed(draw.index_count,
+                               draw.instance_count,
+                               draw.first_index,
+                               draw.vertex_offset,
+                               (draw.instanced ? draw.first_instance : 0));
+        }
+
+        // the gpu scene shares the frame's sets and push constants, its draws were written by the culling pass, so this
+        // is a single indirect draw no matter how many objects there are, it's skipped until its pipeline is ready
+        if (!gpu_scene_.empty()) {
+            const auto* program  = (use_shader_objects_ ? shader_objects_.resolve(gpu_scene_.handle()) : nullptr);
+            const auto  pipeline = (use_shader_objects_ ? vk::Pipeline {} : resolve_pipeline(gpu_scene_.handle()));
+
+            if (program) {
+                encoder.bind_program(*program);
+            } else if (pipeline) {
+                encoder.bind_pipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+            }
+
+            if (program || pipeline) {
+                encoder.set_render_state(gpu_scene_.desc().state);
+                gpu_scene_.record(encoder, graphics_pipeline_.draw_constants());
+            }
+        }
+
+        // sprites go on top of everything else, the sets and push constants stay as they are, only the pipeline changes
+        // the sprite pipeline is compiled in the background, sprites are skipped until it's ready
+        if (!sprite_batch_.empty()) {
+            const auto* program  = (use_shader_objects_ ? shader_objects_.resolve(sprite_batch_.handle()) : nullptr);
+            const auto  pipeline = (use_shader_objects_ ? vk::Pipeline {} : resolve_pipeline(sprite_batch_.handle()));
+
+            if (program) {
+                encoder.bind_program(*program);
+            } else if (pipeline) {
+                encoder.bind_pipeline(vk::PipelineBindPoint::eGraphics, pipeline);
+            }
+
+            if (program || pipeline) {
+                encoder.set_render_state(sprite_batch_.desc().state);
+                sprite_batch_.record(encoder, graphics_pipeline_.draw_constants(), extent_);
+            }
+        }
+
+        end_rendering(buffer, image_index);
         handle_result(buffer.end(), "Failed to finish recording command buffer");
+
+        const auto stats = encoder.stats();
+        log(ELogLvl::TRACE,
+            "Recorded {} draw(s) with {} bind(s), skipped {} redundant one(s)",
+            draw_packets_.size(),
+            stats.binds_issued,
+            stats.binds_skipped);
+        log(ELogLvl::TRACE, "Recorded {} dynamic state change(s), skipped {} redundant one(s)", stats.states_issued, stats.states_skipped);
     }
 
-    void Swapchain::create_command_pool() {
-        const auto pool_info = vk::CommandPoolCreateInfo {
-            .flags            = vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
-            .queueFamilyIndex = graphics_queue_family_index_,
+    auto Swapchain::resolve_pipeline(const PipelineHandle handle) -> vk::Pipeline {
+        const auto [it, inserted] = resolved_pipelines_.try_emplace(handle.key);
+        if (inserted) {
+            it->second = pipeline_library_.resolve(handle);
+        }
+
+        return it->second;
+    }
+
+    void Swapchain::begin_rendering(const vk::CommandBuffer buffer, const u32 image_index) const {
+        const auto clear_color = vk::ClearValue {.color = {std::array {0.0f, 0.0f, 0.0f, 1.0f}}};
+
+        if (!use_shader_objects_) {
+            const auto renderpass_begin_info =
+                vk::RenderPassBeginInfo {
+                    .renderPass  = renderpass_,
+                    .framebuffer = frame_buffers_[image_index],
+                    .renderArea  = vk::Rect2D {.extent = extent_},
+
+                }
+                    .setClearValues(clear_color);
+
+            buffer.beginRenderPass(renderpass_begin_info, vk::SubpassContents::eInline);
+            return;
+        }
+
+        // without a renderpass the layout transition is up to us, the acquire semaphore is waited on at the same stage
+        const auto to_attachment = vk::ImageMemoryBarrier2 {
+            .srcStageMask     = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+            .srcAccessMask    = vk::AccessFlagBits2::eNone,
+            .dstStageMask     = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+            .dstAccessMask    = vk::AccessFlagBits2::eColorAttachmentWrite,
+            .oldLayout        = vk::ImageLayout::eUndefined,
+            .newLayout        = vk::ImageLayout::eColorAttachmentOptimal,
+            .image            = images_[image_index],
+            .subresourceRange = {.aspectMask = vk::ImageAspectFlagBits::eColor, .levelCount = 1, .layerCount = 1},
+        };
+
+        buffer.pipelineBarrier2(vk::DependencyInfo().setImageMemoryBarriers(to_attachment));
+
+        const auto color_attachment = vk::RenderingAttachmentInfo {
+            .imageView   = image_views_[image_index],
+            .imageLayout = vk::ImageLayout::eColorAttachmentOptimal,
+            .loadOp      = vk::AttachmentLoadOp::eClear,
+            .storeOp     = vk::AttachmentStoreOp::eStore,
+            .clearValue  = clear_color,
         };
 
-        const auto [result, pool] = device_.createCommandPool(pool_info);
-        handle_result(result, "Failed to create command pool");
-        command_pool_ = pool;
+        const auto rendering_info =
+            vk::RenderingInfo {
+                .renderArea = vk::Rect2D {.extent = extent_},
+                .layerCount = 1,
+            }
+                .setColorAttachments(color_attachment);
 
-        log(ELogLvl::TRACE, "Created command pool");
+        buffer.beginRendering(rendering_info);
     }
 
-    void Swapchain::create_command_buffer() {
-        const auto buffer_alloc_info = vk::CommandBufferAllocateInfo {
-            .commandPool        = command_pool_,
-            .level              = vk::CommandBufferLevel::ePrimary,
-            .commandBufferCount = cast<u32>(command_buffers_.size()),
+    void Swapchain::end_rendering(const vk::CommandBuffer buffer, const u32 image_index) const {
+        if (!use_shader_objects_) {
+            buffer.endRenderPass();
+            return;
+        }
+
+        buffer.endRendering();
+
+        const auto to_present = vk::ImageMemoryBarrier2 {
+            .srcStageMask     = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+            .srcAccessMask    = vk::AccessFlagBits2::eColorAttachmentWrite,
+            .dstStageMask     = vk::PipelineStageFlagBits2::eNone,
+            .dstAccessMask    = vk::AccessFlagBits2::eNone,
+            .oldLayout        = vk::ImageLayout::eColorAttachmentOptimal,
+            .newLayout        = vk::ImageLayout::ePresentSrcKHR,
+            .image            = images_[image_index],
+            .subresourceRange = {.aspectMask = vk::ImageAspectFlagBits::eColor, .levelCount = 1, .layerCount = 1},
         };
 
-        const auto [result, buffer] = device_.allocateCommandBuffers(buffer_alloc_info);
-        handle_result(result, "Failed to allocate command buffer");
-        command_buffers_ = buffer;
+        buffer.pipelineBarrier2(vk::DependencyInfo().setImageMemoryBarriers(to_present));
+    }
+
+    void Swapchain::create_command_allocator() {
+        // recording is single threaded for now, but each recording thread will need its own pools
+        constexpr u32 recording_threads = 1;
 
-        log(ELogLvl::TRACE, "Created command buffer");
+        command_allocator_.create(graphics_queue_.family_index(), MAX_FRAMES_IN_FLIGHT, recording_threads);
     }
 
     void Swapchain::create_renderpass() {
@@ -390,9 +849,88 @@ namespace sylk {
         log(ELogLvl::TRACE, "Created render pass");
     }
 
-    void Swapchain::set_queues(const vk::Queue graphics, const vk::Queue present) {
-        graphics_queue_     = graphics;
-        presentation_queue_ = present;
+    void Swapchain::set_queues(const QueueFamilyIndices& indices) {
+        graphics_queue_.create(device_.getQueue(indices.graphics.value(), 0), indices.graphics.value());
+
+        // both take queue 0 of their family, so without a dedicated compute family it's the very same VkQueue, a
+        // second wrapper would give it a second timeline that nothing orders against the first
+        compute_shares_graphics_ = (indices.compute_family() == indices.graphics.value());
+        if (!compute_shares_graphics_) {
+            compute_queue_.create(device_.getQueue(indices.compute_family(), 0), indices.compute_family());
+        }
+        presentation_queue_ = device_.getQueue(indices.presentation.value(), 0);
+    }
+
+    void Swapchain::set_device_features(const DeviceFeatures& features) {
+        device_features_ = &features;
+    }
+
+    void Swapchain::set_prefer_shader_objects(const bool prefer) {
+        prefer_shader_objects_ = prefer;
+    }
+
+    void Swapchain::set_sprite_benchmark(const u32 sprite_count) {
+        sprite_benchmark_ = sprite_count;
+    }
+
+    void Swapchain::set_gpu_scene_benchmark(const u32 object_count) {
+        gpu_scene_benchmark_ = object_count;
+    }
+
+    auto Swapchain::graphics_queue() -> Queue& {
+        return graphics_queue_;
+    }
+
+    auto Swapchain::compute_queue() -> Queue& {
+        return (compute_shares_graphics_ ? graphics_queue_ : compute_queue_);
+    }
+
+    auto Swapchain::submit_batcher() -> SubmitBatcher& {
+        return submit_batcher_;
+    }
+
+    auto Swapchain::descriptor_allocator() -> DescriptorAllocator& {
+        return descriptor_allocator_;
+    }
+
+    auto Swapchain::descriptor_buffer() -> DescriptorBuffer& {
+        return descriptor_buffer_;
+    }
+
+    auto Swapchain::bindless_table() -> BindlessTable& {
+        return bindless_table_;
+    }
+
+    auto Swapchain::pipeline_cache() -> PipelineCache& {
+        return pipeline_cache_;
+    }
+
+    auto Swapchain::pipeline_library() -> PipelineLibrary& {
+        return pipeline_library_;
+    }
+
+    auto Swapchain::shader_objects() -> ShaderObjectCache& {
+        return shader_objects_;
+    }
+
+    auto Swapchain::uses_shader_objects() const -> bool {
+        return use_shader_objects_;
+    }
+
+    auto Swapchain::shader_modules() -> ShaderModuleCache& {
+        return shader_modules_;
+    }
+
+    auto Swapchain::default_pipeline() const -> const GraphicsPipeline& {
+        return graphics_pipeline_;
+    }
+
+    auto Swapchain::sprite_atlas() const -> const TextureAtlas& {
+        return sprite_atlas_;
+    }
+
+    auto Swapchain::gpu_scene() -> GpuScene& {
+        return gpu_scene_;
     }
 
     void Swapchain::destroy_partial() {
@@ -475,13 +1013,16 @@ namespace sylk {
     void Swapchain::create_uniform_buffers() {
         vk::DeviceSize buffer_size = sizeof(UniformBufferObject);
 
+        // descriptor buffers reference their buffers by address
+        const auto address_usage = (descriptor_buffer_.valid() ? vk::BufferUsageFlagBits::eShaderDeviceAddress : vk::BufferUsageFlags {});
+
         const auto buffer_data = Buffer::CreateData {
             .data_to_map        = nullptr,
             .persistent_mapping = true,
             .device             = device_,
             .physical_device    = physical_device_,
             .buffer_size        = buffer_size,
-            .buffer_usage_flags = vk::BufferUsageFlagBits::eUniformBuffer,
+            .buffer_usage_flags = vk::BufferUsageFlagBits::eUniformBuffer | address_usage,
             .property_flags     = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
         };
 
@@ -490,18 +1031,20 @@ namespace sylk {
         }
     }
 
-    void Swapchain::update_uniform_buffers() {
-        namespace clock = std::chrono;
+    void Swapchain::create_instance_stream() {
+        instance_stream_.create(physical_device_, vk::BufferUsageFlagBits::eVertexBuffer, MAX_FRAMES_IN_FLIGHT, INSTANCE_STREAM_FRAME_SIZE);
+    }
 
-        static const auto start_time = clock::high_resolution_clock::now();
-        static f32        inc        = 0.0f;
-        static i32        seconds    = 0;
+    void Swapchain::simulate_default_scene(FramePacket& packet) const {
+        static f32 inc     = 0.0f;
+        static i32 seconds = 0;
 
-        const auto current_time = clock::high_resolution_clock::now();
-        const f32  elapsed_time = clock::duration<f32, clock::seconds::period>(current_time - start_time).count();
+        packet.draws.push_back({
+            .index_count = cast<u32>(indices_.size()),
+            .constants   = {.model = glm::rotate(glm::mat4(1.0f), packet.elapsed_time * glm::radians(inc), glm::vec3(0.0f, 0.0f, 1.0f))},
+        });
 
-        auto ubo = UniformBufferObject {
-            .model = glm::rotate(glm::mat4(1.0f), elapsed_time * glm::radians(inc), glm::vec3(0.0f, 0.0f, 1.0f)),
+        packet.ubo = UniformBufferObject {
             //            .view       = glm::lookAt(glm::vec3(2.0f, inc, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 1.0f,
             //            0.0f)), .projection = glm::perspective(glm::radians(45.0f), cast<f32>(extent_.width / extent_.height),
             //            0.1f, 10.0f),
@@ -512,66 +1055,305 @@ namespace sylk {
             incval *= -1.f;
         }
         inc += incval;
-        if (std::trunc(elapsed_time) > seconds) {
-            seconds = cast<i32>(elapsed_time);
+        if (std::trunc(packet.elapsed_time) > seconds) {
+            seconds = cast<i32>(packet.elapsed_time);
             log(ELogLvl::DEBUG, "inc: {}", inc);
-            log(ELogLvl::INFO, "elapsed: {}", elapsed_time);
+            log(ELogLvl::INFO, "elapsed: {}", packet.elapsed_time);
         }
 
         // invert y axis since glm was designed for OGL and VK isn't weird
-        ubo.projection[1][1] *= -1;
+        packet.ubo.projection[1][1] *= -1;
+    }
 
-        uniform_buffers_[current_frame_].pass_data(&ubo, sizeof(ubo));
+    void Swapchain::simulate_sprite_benchmark(FramePacket& packet) const {
+        static u64 frames  = 0;
+        static i32 seconds = 0;
+
+        const u32 regions = sprite_atlas_.region_count();
+        if (regions == 0) {
+            return;
+        }
+
+        const auto width  = cast<f32>(extent_.width);
+        const auto height = cast<f32>(extent_.height);
+
+        // every sprite drifts in a straight line from a fixed start, so a frame is a pure function of the elapsed time
+        packet.sprites.reserve(sprite_benchmark_);
+        for (u32 i = 0; i < sprite_benchmark_; ++i) {
+            const u32 a = scatter(i);
+            const u32 b = scatter(a);
+            const u32 c = scatter(b);
+
+            const f32 heading = unit(b) * glm::two_pi<f32>();
+            const f32 speed   = 20.0f + 80.0f * unit(c);
+
+            packet.sprites.push_back({
+                .position = {wrap(unit(a) * width + std::cos(heading) * speed * packet.elapsed_time, width),
+                             wrap(unit(a >> 8) * height + std::sin(heading) * speed * packet.elapsed_time, height)},
+                .size     = glm::vec2(8.0f + 16.0f * unit(c >> 8)),
+                .rotation = (unit(b >> 8) - 0.5f) * 4.0f * packet.elapsed_time,
+                .region   = sprite_atlas_.region(a % regions),
+                .layer    = cast<i16>(c % 4),
+            });
+        }
+
+        ++frames;
+        if (std::trunc(packet.elapsed_time) > seconds) {
+            const auto stats = sprite_batch_.stats();
+            log(ELogLvl::INFO, "{} fps, {} sprite(s) in {} batch(es)", frames, stats.sprites, stats.batches);
+
+            seconds = cast<i32>(packet.elapsed_time);
+            frames  = 0;
+        }
     }
 
-    void Swapchain::create_descriptor_pool() {
-        const auto num_buffers = cast<u32>(uniform_buffers_.size());
-        const auto pool_size   = vk::DescriptorPoolSize {
-              .descriptorCount = num_buffers,
-        };
+    void Swapchain::simulate_gpu_scene_benchmark(FramePacket& packet) const {
+        static u64 frames  = 0;
+        static i32 seconds = 0;
+
+        // the objects never change, only the camera moves, it circles the origin and zooms in and out, so most of the
+        // scene is culled at any time and what's culled keeps changing
+        const f32  aspect      = cast<f32>(extent_.width) / cast<f32>(std::max(extent_.height, 1u));
+        const f32  half_height = 2.0f + 1.5f * std::sin(packet.elapsed_time * 0.3f);
+        const auto camera      = glm::vec3(std::cos(packet.elapsed_time * 0.1f), std::sin(packet.elapsed_time * 0.1f), 0.0f) *
+                                 (GPU_SCENE_BENCHMARK_EXTENT * 0.5f);
+
+        const auto zoom = glm::scale(glm::mat4(1.0f), glm::vec3(1.0f / (half_height * aspect), 1.0f / half_height, 1.0f));
+        packet.scene_view_projection = glm::translate(zoom, -camera);
+
+        ++frames;
+        if (std::trunc(packet.elapsed_time) > seconds) {
+            log(ELogLvl::INFO,
+                "{} fps, {} gpu scene object(s), {} waiting for upload",
+                frames,
+                gpu_scene_.object_count(),
+                gpu_scene_.pending_uploads());
+
+            seconds = cast<i32>(packet.elapsed_time);
+            frames  = 0;
+        }
+    }
 
-        const auto pool_info =
-            vk::DescriptorPoolCreateInfo {
-                .maxSets = num_buffers,
+    void Swapchain::create_descriptor_backend() {
+        // a pipeline either uses descriptor buffers for every set or for none, so this decides for everything at once
+        if (!device_features_->supports_descriptor_buffer()) {
+            pipeline_layouts_.create(physical_device_);
+            descriptor_allocator_.create(MAX_FRAMES_IN_FLIGHT);
+
+            // the per frame set is tiny and changes every frame, so it's recorded into the command buffer when possible
+            push_frame_descriptors_ = device_features_->supports_push_descriptor();
+            if (push_frame_descriptors_) {
+                pipeline_layouts_.push_set(0);
             }
-                .setPoolSizes(pool_size);
 
-        const auto [result, pool] = device_.createDescriptorPool(pool_info);
-        handle_result(result, "Failed to create descriptor pool");
-        descriptor_pool_ = pool;
+            return;
+        }
+
+        pipeline_layouts_.create(physical_device_, vk::DescriptorSetLayoutCreateFlagBits::eDescriptorBufferEXT);
+        descriptor_buffer_.create(physical_device_, MAX_FRAMES_IN_FLIGHT, DESCRIPTOR_BUFFER_FRAME_SIZE, DESCRIPTOR_BUFFER_PERSISTENT_SIZE);
+    }
+
+    void Swapchain::create_bindless_table() {
+        if (!device_features_->supports_bindless()) {
+            log(ELogLvl::WARN, "Device lacks descriptor indexing, running without a bindless table");
+            return;
+        }
+
+        bindless_table_.create(physical_device_, MAX_FRAMES_IN_FLIGHT, (descriptor_buffer_.valid() ? &descriptor_buffer_ : nullptr));
+
+        // every layout carries the table, so binding it once per frame is enough
+        pipeline_layouts_.reserve_set(BindlessTable::SET, bindless_table_.layout());
+    }
+
+    void Swapchain::create_sprite_batch() {
+        // sprites sample their pages through the bindless table, there's no other way for them to reach a texture
+        if (!bindless_table_.valid()) {
+            log(ELogLvl::WARN, "Running without a sprite batch, it needs a bindless table");
+            return;
+        }
+
+        sprite_batch_.create(physical_device_, MAX_FRAMES_IN_FLIGHT, bindless_table_, pipeline_layouts_, graphics_pipeline_.base_desc());
+        sprite_batch_.set_handle(use_shader_objects_ ? shader_objects_.request(sprite_batch_.desc())
+                                                     : pipeline_library_.request(sprite_batch_.desc()));
+    }
+
+    void Swapchain::create_sprite_atlas(const vk::CommandBuffer cmd_buffer) {
+        // a generated stand-in until textures are loaded from disk, staged like the static geometry
+        for (u32 i = 0; i < SPRITE_ATLAS_PAGES; ++i) {
+            const auto texels = sprite_page_texels(i);
+
+            Buffer staging_buffer;
+            staging_buffer.create({
+                .data_to_map        = texels.data(),
+                .device             = device_,
+                .physical_device    = physical_device_,
+                .buffer_size        = texels.size() * sizeof(texels[0]),
+                .buffer_usage_flags = vk::BufferUsageFlagBits::eTransferSrc,
+                .property_flags     = vk::MemoryPropertyFlagBits::eHostCoherent | vk::MemoryPropertyFlagBits::eHostVisible,
+            });
+
+            auto& page = sprite_pages_.emplace_back();
+            page.create({
+                .device          = device_,
+                .physical_device = physical_device_,
+                .extent          = {SPRITE_ATLAS_PAGE_SIZE, SPRITE_ATLAS_PAGE_SIZE},
+            });
+            page.upload(cmd_buffer, staging_buffer.vk_buffer());
+            staging_buffers_.push_back(staging_buffer);
+
+            const auto page_id = sprite_atlas_.add_page(bindless_table_.add_image(page.view()), page.extent());
+            sprite_atlas_.add_grid(page_id, {SPRITE_ATLAS_CELL_SIZE, SPRITE_ATLAS_CELL_SIZE});
+        }
+
+        log(ELogLvl::TRACE, "Created sprite atlas with {} region(s) on {} page(s)", sprite_atlas_.region_count(), sprite_atlas_.page_count());
+    }
+
+    void Swapchain::create_gpu_scene() {
+        if (!device_features_->supports_draw_indirect_count()) {
+            log(ELogLvl::WARN, "Running without a gpu scene, it needs indirect draw counts");
+            return;
+        }
+
+        gpu_scene_.create(physical_device_,
+                          MAX_FRAMES_IN_FLIGHT,
+                          GPU_SCENE_CAPACITY,
+                          pipeline_layouts_,
+                          pipeline_cache_.get_handle(),
+                          *device_features_,
+                          descriptor_allocator_,
+                          (descriptor_buffer_.valid() ? &descriptor_buffer_ : nullptr),
+                          graphics_pipeline_.base_desc());
+        gpu_scene_.set_handle(use_shader_objects_ ? shader_objects_.request(gpu_scene_.desc())
+                                                  : pipeline_library_.request(gpu_scene_.desc()));
+
+        // the benchmark scene is added once, from here on the cpu never touches it again
+        const u32 object_count = std::min(gpu_scene_benchmark_, GPU_SCENE_CAPACITY);
+        for (u32 i = 0; i < object_count; ++i) {
+            const u32 a = scatter(i);
+            const u32 b = scatter(a);
+
+            const auto position = glm::vec3((unit(a) * 2.0f - 1.0f) * GPU_SCENE_BENCHMARK_EXTENT,
+                                            (unit(a >> 8) * 2.0f - 1.0f) * GPU_SCENE_BENCHMARK_EXTENT,
+                                            0.0f);
+
+            auto model = glm::translate(glm::mat4(1.0f), position);
+            model      = glm::rotate(model, unit(b) * glm::two_pi<f32>(), glm::vec3(0.0f, 0.0f, 1.0f));
+            model      = glm::scale(model, glm::vec3(0.02f + 0.06f * unit(b >> 8)));
+
+            // the quad spans [-0.5, 0.5], its corners are the furthest from the centre
+            gpu_scene_.add({
+                .model       = model,
+                .bounds      = {0.0f, 0.0f, 0.0f, glm::root_two<f32>() * 0.5f},
+                .index_count = cast<u32>(indices_.size()),
+            });
+        }
     }
 
     void Swapchain::create_descriptor_sets() {
-        std::vector<vk::DescriptorSetLayout> set_layouts(MAX_FRAMES_IN_FLIGHT, graphics_pipeline_.get_descriptor_set_layout());
+        const auto set_layout = graphics_pipeline_.get_descriptor_set_layout();
+
+        // the uniform buffers never change, so their descriptors are written once and outlive every frame
+        if (descriptor_buffer_.valid()) {
+            for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+                frame_descriptors_[i] = descriptor_buffer_.allocate_persistent(set_layout);
+                descriptor_buffer_.write_buffer(frame_descriptors_[i],
+                                                set_layout,
+                                                0,
+                                                vk::DescriptorType::eUniformBuffer,
+                                                uniform_buffers_[i].device_address(device_),
+                                                sizeof(UniformBufferObject));
+            }
+
+            return;
+        }
 
-        const auto alloc_info = vk::DescriptorSetAllocateInfo {.descriptorPool = descriptor_pool_}.setSetLayouts(set_layouts);
+        frame_descriptor_template_.create(graphics_pipeline_.cached_layout(), 0, push_frame_descriptors_);
 
-        const auto [result, sets] = device_.allocateDescriptorSets(alloc_info);
-        handle_result(result, "Failed to allocate descriptor sets");
-        descriptor_sets_ = sets;
+        // pushed sets are never allocated
+        if (push_frame_descriptors_) {
+            return;
+        }
 
         for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
-            const auto buffer_info = vk::DescriptorBufferInfo {
-                .buffer = uniform_buffers_[i].vk_buffer(),
-                .offset = 0,
-                .range  = sizeof(UniformBufferObject),
-            };
+            descriptor_sets_[i] = descriptor_allocator_.allocate_persistent(set_layout);
+            frame_descriptor_template_.update(descriptor_sets_[i],
+                                              FrameDescriptors {
+                                                  .uniforms = {.buffer = uniform_buffers_[i].vk_buffer(),
+                                                               .offset = 0,
+                                                               .range  = sizeof(UniformBufferObject)},
+                                              });
+        }
+    }
 
-            const auto write_descript_set = vk::WriteDescriptorSet {
-                .dstSet          = descriptor_sets_[i],
-                .dstBinding      = 0,
-                .dstArrayElement = 0,
-                .descriptorCount = 1,
-                .descriptorType  = vk::DescriptorType::eUniformBuffer,
-                .pBufferInfo     = &buffer_info,
-            };
+#ifdef SYLK_SHADER_HOT_RELOAD
+    void Swapchain::apply_shader_reloads() {
+        for (const auto& reload : shader_hot_reload_.poll()) {
+            auto [replaced, replacement] = graphics_pipeline_.reload_shader(reload.source_name, reload.code);
+            if (!replaced && sprite_batch_.valid()) {
+                std::tie(replaced, replacement) = sprite_batch_.reload_shader(reload.source_name, reload.code);
+            }
+            if (!replaced && gpu_scene_.valid()) {
+                std::tie(replaced, replacement) = gpu_scene_.reload_shader(reload.source_name, reload.code);
+            }
 
-            device_.updateDescriptorSets(write_descript_set, nullptr);
+            if (!replaced) {
+                log(ELogLvl::DEBUG, "{} changed, but isn't used by any pipeline", reload.source_name);
+                continue;
+            }
+
+            // shader objects are rebuilt right here, pipelines are rebuilt by the library's workers
+            const u32 rebuilt = (use_shader_objects_ ? shader_objects_.replace_module(replaced, replacement)
+                                                     : pipeline_library_.replace_module(replaced, replacement));
+            log(ELogLvl::INFO, "Reloaded {}, rebuilding {} pipeline(s)", reload.source_name, rebuilt);
+        }
+
+        if (use_shader_objects_) {
+            return;
+        }
+
+        if (const u32 swapped = pipeline_library_.swap_reloaded(); swapped > 0) {
+            log(ELogLvl::DEBUG, "Swapped in {} reloaded pipeline(s)", swapped);
         }
     }
+#endif
+
+    void Swapchain::upload_static_geometry() {
+        // nothing is in flight yet, so the current slot can be reset without waiting
+        command_allocator_.begin_frame(current_frame_);
+        const auto cmd_buffer = command_allocator_.allocate();
+
+        const auto begin_info = vk::CommandBufferBeginInfo {.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit};
+        handle_result(cmd_buffer.begin(begin_info), "Failed to begin recording command buffer");
+
+        // every upload shares one command buffer, and therefore one submission
+        create_staged_buffer(vertex_buffer_, vk::BufferUsageFlagBits::eVertexBuffer, vertices_, cmd_buffer);
+        create_staged_buffer(index_buffer_, vk::BufferUsageFlagBits::eIndexBuffer, indices_, cmd_buffer);
+        if (sprite_batch_.valid()) {
+            create_sprite_atlas(cmd_buffer);
+        }
+
+        handle_result(cmd_buffer.end(), "Failed to stop recording command buffer");
+
+        submit_batcher_.add(graphics_queue_, {.command_buffers = {&cmd_buffer, 1}});
+        submit_batcher_.flush();
+        submit_batcher_.end_frame();
+
+        const auto& timeline = graphics_queue_.get_timeline();
+        timeline.wait(timeline.last_claimed_value());
+
+        for (auto& staging_buffer : staging_buffers_) {
+            staging_buffer.destroy_with(device_);
+        }
+        staging_buffers_.clear();
+
+        log(ELogLvl::TRACE, "Uploaded static geometry");
+    }
 
     template<typename T>
-    void Swapchain::create_staged_buffer(Buffer& buffer, vk::BufferUsageFlags buffer_type, const std::vector<T>& data) {
+    void Swapchain::create_staged_buffer(Buffer&                   buffer,
+                                         const vk::BufferUsageFlags buffer_type,
+                                         const std::vector<T>&      data,
+                                         const vk::CommandBuffer    cmd_buffer) {
         const vk::DeviceSize buffer_size = sizeof(data[0]) * data.size();
 
         Buffer     staging_buffer;
@@ -597,14 +1379,13 @@ namespace sylk {
 
         buffer.create(buffer_data);
 
-        staging_buffer.copy_onto({
-            .target = buffer.vk_buffer(),
-            .size   = buffer_size,
-            .pool   = command_pool_,
-            .device = device_,
-            .queue  = graphics_queue_,
-        });
+        staging_buffer.copy_onto(cmd_buffer,
+                                 {
+                                     .target = buffer.vk_buffer(),
+                                     .size   = buffer_size,
+                                 });
 
-        staging_buffer.destroy_with(device_);
+        // the copy hasn't executed yet, so the staging buffer has to live until the submission completes
+        staging_buffers_.push_back(staging_buffer);
     }
-}  // namespace sylk
\ No newline at end of file
+}  // namespace sylk
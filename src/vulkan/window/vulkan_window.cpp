@@ -11,20 +11,33 @@
 #include <sylk/vulkan/utils/validation_layers.hpp>
 #include <sylk/vulkan/window/vulkan_window.hpp>
 
+#include <chrono>
 #include <set>
 
+// the one definition of the default dispatcher every vulkan-hpp call goes through
+VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
+
 namespace sylk {
 
     VulkanWindow::VulkanWindow(const Settings settings)
         : validation_layers_(instance_)
         , settings_(settings)
         , swapchain_(device_) {
+        const auto startup_begin = std::chrono::steady_clock::now();
+
         create_window();
         create_instance();
         create_surface();
         select_physical_device();
         create_logical_device();
         swapchain_.create(physical_device_, window_, surface_);
+
+        // compare across runs to see what a warm pipeline cache saves
+        const auto startup_time = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - startup_begin);
+        log(ELogLvl::INFO,
+            "Started up in {:.2f} ms with a {} pipeline cache",
+            startup_time.count(),
+            (swapchain_.pipeline_cache().was_warm() ? "warm" : "cold"));
     }
 
     VulkanWindow::~VulkanWindow() {
@@ -52,6 +65,12 @@ namespace sylk {
 
     void VulkanWindow::render() { swapchain_.draw_next(); }
 
+    void VulkanWindow::simulate(const Swapchain::SimulateCallback& callback) { swapchain_.simulate(callback); }
+
+    void VulkanWindow::build_draw_list() { swapchain_.build_draw_list(); }
+
+    void VulkanWindow::record_and_submit() { swapchain_.record_and_submit(); }
+
     std::span<const char*> VulkanWindow::fetch_required_extensions(const bool force_update) {
         log(ELogLvl::TRACE, "Querying available Vulkan extensions...");
 
@@ -66,6 +85,9 @@ namespace sylk {
     }
 
     void VulkanWindow::create_instance() {
+        // only global commands can be loaded until there's an instance, the rest is filled in once it exists
+        VULKAN_HPP_DEFAULT_DISPATCHER.init(vkGetInstanceProcAddr);
+
         if (ValidationLayers::enabled() && !validation_layers_.supports_required_layers()) {
             log(ELogLvl::CRITICAL,
                 "Missing validation layers are likely a flaw of an incomplete Vulkan SDK.\n"
@@ -100,6 +122,7 @@ namespace sylk {
         const auto [result, instance] = vk::createInstance(instance_info);
         handle_result(result, "Failed to create Vulkan instance", ELogLvl::CRITICAL);
         instance_ = instance;
+        VULKAN_HPP_DEFAULT_DISPATCHER.init(instance_);
 
         log(ELogLvl::DEBUG, "Created Vulkan instance");
     }
@@ -197,8 +220,11 @@ namespace sylk {
 
         const bool swapchain_supported = !swapchain_support.surface_formats.empty() && !swapchain_support.present_modes.empty();
 
+        DeviceFeatures features;
+        features.query(device);
+
         return QueueFamilyIndices::find(device, surface_).has_required() && device_supports_required_extensions(device) &&
-               swapchain_supported;
+               swapchain_supported && features.supports_required();
     }
 
     void VulkanWindow::create_logical_device() {
@@ -206,7 +232,9 @@ namespace sylk {
 
         const f32                              queue_prio = 1.f;
         std::vector<vk::DeviceQueueCreateInfo> queue_create_infos;
-        const std::set<u32>                    unique_queue_families {queue_indices.graphics.value(), queue_indices.presentation.value()};
+        const std::set<u32>                    unique_queue_families {queue_indices.graphics.value(),
+                                                   queue_indices.presentation.value(),
+                                                   queue_indices.compute_family()};
         for (const auto family : unique_queue_families) {
             const auto dev_queue_create_info =
                 vk::DeviceQueueCreateInfo {
@@ -217,10 +245,16 @@ namespace sylk {
             queue_create_infos.push_back(dev_queue_create_info);
         }
 
-        const auto dev_features = vk::PhysicalDeviceFeatures();
+        device_features_.query(physical_device_);
+
+        std::vector<const char*> device_extensions(required_device_extensions_.begin(), required_device_extensions_.end());
+        device_extensions.insert(device_extensions.end(),
+                                 device_features_.enabled_extensions().begin(),
+                                 device_features_.enabled_extensions().end());
 
         const auto dev_create_info =
             vk::DeviceCreateInfo {
+                .pNext = &device_features_.chain(),
 #ifdef SYLK_DEBUG
                 .enabledLayerCount   = validation_layers_.enabled_layer_count(),
                 .ppEnabledLayerNames = validation_layers_.enabled_layer_container().data(),
@@ -228,19 +262,26 @@ namespace sylk {
                 .enabledLayerCount = 0,
 #endif
 
-                .enabledExtensionCount   = cast<u32>(required_device_extensions_.size()),
-                .ppEnabledExtensionNames = required_device_extensions_.data(),
-                .pEnabledFeatures        = &dev_features,
+                .enabledExtensionCount   = cast<u32>(device_extensions.size()),
+                .ppEnabledExtensionNames = device_extensions.data(),
             }
                 .setQueueCreateInfos(queue_create_infos);
 
         const auto [result, dev] = physical_device_.createDevice(dev_create_info);
         handle_result(result, "Failed to create logical Vulkan device", ELogLvl::CRITICAL);
         device_ = dev;
+        VULKAN_HPP_DEFAULT_DISPATCHER.init(device_);
 
-        swapchain_.set_queues(device_.getQueue(queue_indices.graphics.value(), 0), device_.getQueue(queue_indices.presentation.value(), 0));
+        swapchain_.set_queues(queue_indices);
+        swapchain_.set_device_features(device_features_);
+        swapchain_.set_prefer_shader_objects(settings_.shader_objects);
+        swapchain_.set_sprite_benchmark(settings_.sprite_benchmark);
+        swapchain_.set_gpu_scene_benchmark(settings_.gpu_scene_benchmark);
 
         log(ELogLvl::DEBUG, "Created Vulkan logical device");
+        log(ELogLvl::DEBUG,
+            "Async compute {}",
+            (queue_indices.has_async_compute() ? "enabled on a dedicated queue family" : "unavailable, sharing the graphics queue"));
     }
 
     void VulkanWindow::create_surface() {
@@ -0,0 +1,755 @@
+//
+// Created by August Silva on 18-10-26.
+//
+
+// build time spir-v reflection, turns a module into a header of constexpr tables for <sylk/vulkan/shader/shader_reflection.hpp>
+// usage: sylk_reflect <input.spv> <output.hpp> <IDENTIFIER> <source name>
+//
+// only the subset of spir-v that glsl shaders produce is understood, anything else is reported and fails the build
+
+#include <sylk/core/utils/short_types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+    using namespace sylk;
+
+    constexpr u32 SPIRV_MAGIC = 0x07230203;
+    constexpr u32 HEADER_SIZE = 5;
+
+    // opcodes, decorations and enums as numbered in the spir-v specification
+    enum EOp : u32 {
+        OP_NAME                  = 5,
+        OP_ENTRY_POINT           = 15,
+        OP_EXECUTION_MODE        = 16,
+        OP_TYPE_VOID             = 19,
+        OP_TYPE_BOOL             = 20,
+        OP_TYPE_INT              = 21,
+        OP_TYPE_FLOAT            = 22,
+        OP_TYPE_VECTOR           = 23,
+        OP_TYPE_MATRIX           = 24,
+        OP_TYPE_IMAGE            = 25,
+        OP_TYPE_SAMPLER          = 26,
+        OP_TYPE_SAMPLED_IMAGE    = 27,
+        OP_TYPE_ARRAY            = 28,
+        OP_TYPE_RUNTIME_ARRAY    = 29,
+        OP_TYPE_STRUCT           = 30,
+        OP_TYPE_POINTER          = 32,
+        OP_CONSTANT              = 43,
+        OP_SPEC_CONSTANT_TRUE    = 48,
+        OP_SPEC_CONSTANT_FALSE   = 49,
+        OP_SPEC_CONSTANT         = 50,
+        OP_VARIABLE              = 59,
+        OP_DECORATE              = 71,
+        OP_MEMBER_DECORATE       = 72,
+        OP_TYPE_ACCELERATION_KHR = 5341,
+    };
+
+    enum EDecoration : u32 {
+        DECORATION_SPEC_ID        = 1,
+        DECORATION_BLOCK          = 2,
+        DECORATION_BUFFER_BLOCK   = 3,
+        DECORATION_ARRAY_STRIDE   = 6,
+        DECORATION_MATRIX_STRIDE  = 7,
+        DECORATION_BUILT_IN       = 11,
+        DECORATION_LOCATION       = 30,
+        DECORATION_BINDING        = 33,
+        DECORATION_DESCRIPTOR_SET = 34,
+        DECORATION_OFFSET         = 35,
+    };
+
+    enum EExecutionMode : u32 {
+        EXECUTION_MODE_LOCAL_SIZE    = 17,
+        EXECUTION_MODE_LOCAL_SIZE_ID = 38,
+    };
+
+    enum EStorageClass : u32 {
+        STORAGE_UNIFORM_CONSTANT = 0,
+        STORAGE_INPUT            = 1,
+        STORAGE_UNIFORM          = 2,
+        STORAGE_PUSH_CONSTANT    = 9,
+        STORAGE_STORAGE_BUFFER   = 12,
+    };
+
+    // vertex inputs named with this prefix are fed per instance from their own binding, glsl has no way to say so
+    constexpr const char* INSTANCE_INPUT_PREFIX = "instance_";
+
+    constexpr u32 IMAGE_DIM_BUFFER       = 5;
+    constexpr u32 IMAGE_DIM_SUBPASS_DATA = 6;
+
+    struct Type {
+        u32              op = 0;
+        std::vector<u32> operands;
+    };
+
+    struct Decorations {
+        std::optional<u32> set;
+        std::optional<u32> binding;
+        std::optional<u32> location;
+        std::optional<u32> spec_id;
+        std::optional<u32> array_stride;
+        bool               block        = false;
+        bool               buffer_block = false;
+        bool               built_in     = false;
+    };
+
+    struct MemberDecorations {
+        std::optional<u32> offset;
+        std::optional<u32> matrix_stride;
+        bool               built_in = false;
+    };
+
+    struct Variable {
+        u32 id;
+        u32 pointer_type;
+        u32 storage_class;
+    };
+
+    struct Binding {
+        u32         set;
+        u32         binding;
+        std::string type;
+        u32         count;
+    };
+
+    struct VertexInput {
+        u32         location;
+        std::string format;
+        u32         size;
+        bool        per_instance;
+    };
+
+    struct SpecConstant {
+        u32         id;
+        u32         size;
+        std::string type;
+    };
+
+    class Module {
+      public:
+        explicit Module(std::vector<u32> words)
+            : words_(std::move(words)) {}
+
+        auto parse() -> bool;
+
+        auto stage() const -> const std::string& { return stage_; }
+        auto bindings() const -> std::vector<Binding>;
+        auto push_constant_range() const -> std::optional<std::pair<u32, u32>>;
+        auto vertex_inputs() const -> std::vector<VertexInput>;
+        auto spec_constants() const -> std::vector<SpecConstant>;
+        auto local_size() const -> std::array<u32, 3>;
+
+      private:
+        auto descriptor_type(u32 type_id, u32 storage_class) const -> std::string;
+        auto type_size(u32 type_id) const -> u32;
+        auto struct_size(u32 type_id) const -> u32;
+        auto vertex_format(u32 type_id) const -> std::optional<std::pair<std::string, u32>>;
+        auto spec_constant_type(u32 type_id) const -> std::string;
+        auto constant_value(u32 id) const -> u32;
+        auto pointee(u32 pointer_type) const -> u32;
+        auto is_built_in(u32 variable_id, u32 type_id) const -> bool;
+
+      private:
+        std::vector<u32>                                words_;
+        std::string                                     stage_;
+        std::vector<u32>                                local_size_operands_;
+        bool                                            local_size_ids_ = false;
+        std::map<u32, Type>                             types_;
+        std::map<u32, std::string>                      names_;
+        std::map<u32, u32>                              constants_;
+        std::map<u32, u32>                              spec_constant_types_;
+        std::map<u32, Decorations>                      decorations_;
+        std::map<u32, std::map<u32, MemberDecorations>> member_decorations_;
+        std::vector<Variable>                           variables_;
+    };
+
+    auto execution_model_stage(const u32 model) -> std::optional<std::string> {
+        switch (model) {
+        case 0:
+            return "eVertex";
+        case 1:
+            return "eTessellationControl";
+        case 2:
+            return "eTessellationEvaluation";
+        case 3:
+            return "eGeometry";
+        case 4:
+            return "eFragment";
+        case 5:
+            return "eCompute";
+        default:
+            return std::nullopt;
+        }
+    }
+
+    auto Module::parse() -> bool {
+        if (words_.size() < HEADER_SIZE || words_[0] != SPIRV_MAGIC) {
+            std::cerr << "sylk_reflect: input is not a spir-v module\n";
+            return false;
+        }
+
+        for (u64 i = HEADER_SIZE; i < words_.size();) {
+            const u32 word_count = words_[i] >> 16;
+            const u32 op         = words_[i] & 0xffff;
+
+            if (word_count == 0 || i + word_count > words_.size()) {
+                std::cerr << "sylk_reflect: malformed instruction at word " << i << "\n";
+                return false;
+            }
+
+            const auto first    = words_.begin() + static_cast<i64>(i);
+            const auto operands = std::vector<u32>(first + 1, first + word_count);
+            i += word_count;
+
+            switch (op) {
+            case OP_NAME:
+                // OpName: target, then a nul terminated string packed into the remaining words
+                if (operands.size() > 1) {
+                    const auto* chars = reinterpret_cast<const char*>(operands.data() + 1);
+                    names_[operands[0]] = std::string(chars, strnlen(chars, (operands.size() - 1) * sizeof(u32)));
+                }
+                break;
+            case OP_ENTRY_POINT:
+                if (const auto stage = execution_model_stage(operands[0]); stage && stage_.empty()) {
+                    stage_ = *stage;
+                }
+                break;
+            case OP_EXECUTION_MODE:
+                // OpExecutionMode: entry point, mode, x, y, z, the id variant names constants that may not be parsed yet
+                if (operands[1] == EXECUTION_MODE_LOCAL_SIZE || operands[1] == EXECUTION_MODE_LOCAL_SIZE_ID) {
+                    local_size_operands_ = {operands.begin() + 2, operands.end()};
+                    local_size_ids_      = (operands[1] == EXECUTION_MODE_LOCAL_SIZE_ID);
+                }
+                break;
+            case OP_TYPE_VOID:
+            case OP_TYPE_BOOL:
+            case OP_TYPE_INT:
+            case OP_TYPE_FLOAT:
+            case OP_TYPE_VECTOR:
+            case OP_TYPE_MATRIX:
+            case OP_TYPE_IMAGE:
+            case OP_TYPE_SAMPLER:
+            case OP_TYPE_SAMPLED_IMAGE:
+            case OP_TYPE_ARRAY:
+            case OP_TYPE_RUNTIME_ARRAY:
+            case OP_TYPE_STRUCT:
+            case OP_TYPE_POINTER:
+            case OP_TYPE_ACCELERATION_KHR:
+                types_[operands[0]] = Type {.op = op, .operands = {operands.begin() + 1, operands.end()}};
+                break;
+            case OP_CONSTANT:
+                constants_[operands[1]] = operands[2];
+                break;
+            case OP_SPEC_CONSTANT_TRUE:
+            case OP_SPEC_CONSTANT_FALSE:
+            case OP_SPEC_CONSTANT:
+                spec_constant_types_[operands[1]] = operands[0];
+                break;
+            case OP_VARIABLE:
+                variables_.push_back({.id = operands[1], .pointer_type = operands[0], .storage_class = operands[2]});
+                break;
+            case OP_DECORATE: {
+                auto& decorations = decorations_[operands[0]];
+                switch (operands[1]) {
+                case DECORATION_SPEC_ID:
+                    decorations.spec_id = operands[2];
+                    break;
+                case DECORATION_BLOCK:
+                    decorations.block = true;
+                    break;
+                case DECORATION_BUFFER_BLOCK:
+                    decorations.buffer_block = true;
+                    break;
+                case DECORATION_ARRAY_STRIDE:
+                    decorations.array_stride = operands[2];
+                    break;
+                case DECORATION_BUILT_IN:
+                    decorations.built_in = true;
+                    break;
+                case DECORATION_LOCATION:
+                    decorations.location = operands[2];
+                    break;
+                case DECORATION_BINDING:
+                    decorations.binding = operands[2];
+                    break;
+                case DECORATION_DESCRIPTOR_SET:
+                    decorations.set = operands[2];
+                    break;
+                default:
+                    break;
+                }
+                break;
+            }
+            case OP_MEMBER_DECORATE: {
+                auto& decorations = member_decorations_[operands[0]][operands[1]];
+                switch (operands[2]) {
+                case DECORATION_OFFSET:
+                    decorations.offset = operands[3];
+                    break;
+                case DECORATION_MATRIX_STRIDE:
+                    decorations.matrix_stride = operands[3];
+                    break;
+                case DECORATION_BUILT_IN:
+                    decorations.built_in = true;
+                    break;
+                default:
+                    break;
+                }
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        if (stage_.empty()) {
+            std::cerr << "sylk_reflect: module has no supported entry point\n";
+            return false;
+        }
+
+        return true;
+    }
+
+    auto Module::pointee(const u32 pointer_type) const -> u32 {
+        // OpTypePointer: storage class, pointee type
+        return types_.at(pointer_type).operands[1];
+    }
+
+    auto Module::constant_value(const u32 id) const -> u32 {
+        const auto it = constants_.find(id);
+        if (it == constants_.end()) {
+            throw std::runtime_error("array length is not a plain constant, specialized array sizes aren't supported");
+        }
+
+        return it->second;
+    }
+
+    auto Module::descriptor_type(u32 type_id, const u32 storage_class) const -> std::string {
+        // descriptor arrays are unwrapped by the caller, so only the element type is left here
+        const auto& decorations = (decorations_.contains(type_id) ? decorations_.at(type_id) : Decorations {});
+        const auto& type        = types_.at(type_id);
+
+        if (storage_class == STORAGE_STORAGE_BUFFER || (storage_class == STORAGE_UNIFORM && decorations.buffer_block)) {
+            return "eStorageBuffer";
+        }
+
+        if (storage_class == STORAGE_UNIFORM) {
+            return "eUniformBuffer";
+        }
+
+        switch (type.op) {
+        case OP_TYPE_SAMPLER:
+            return "eSampler";
+        case OP_TYPE_SAMPLED_IMAGE:
+            return "eCombinedImageSampler";
+        case OP_TYPE_ACCELERATION_KHR:
+            return "eAccelerationStructureKHR";
+        case OP_TYPE_IMAGE: {
+            // OpTypeImage: sampled type, dim, depth, arrayed, ms, sampled, format
+            const u32 dim     = type.operands[1];
+            const u32 sampled = type.operands[5];
+
+            if (dim == IMAGE_DIM_SUBPASS_DATA) {
+                return "eInputAttachment";
+            }
+
+            if (dim == IMAGE_DIM_BUFFER) {
+                return (sampled == 2 ? "eStorageTexelBuffer" : "eUniformTexelBuffer");
+            }
+
+            return (sampled == 2 ? "eStorageImage" : "eSampledImage");
+        }
+        default:
+            throw std::runtime_error("unsupported descriptor type");
+        }
+    }
+
+    auto Module::bindings() const -> std::vector<Binding> {
+        std::vector<Binding> bindings;
+
+        for (const auto& variable : variables_) {
+            if (variable.storage_class != STORAGE_UNIFORM_CONSTANT && variable.storage_class != STORAGE_UNIFORM &&
+                variable.storage_class != STORAGE_STORAGE_BUFFER) {
+                continue;
+            }
+
+            const auto decorations = decorations_.find(variable.id);
+            if (decorations == decorations_.end() || !decorations->second.binding) {
+                continue;
+            }
+
+            u32 type_id = pointee(variable.pointer_type);
+            u32 count   = 1;
+
+            if (types_.at(type_id).op == OP_TYPE_ARRAY) {
+                count   = constant_value(types_.at(type_id).operands[1]);
+                type_id = types_.at(type_id).operands[0];
+            } else if (types_.at(type_id).op == OP_TYPE_RUNTIME_ARRAY) {
+                count   = 0;
+                type_id = types_.at(type_id).operands[0];
+            }
+
+            bindings.push_back({
+                .set     = decorations->second.set.value_or(0),
+                .binding = *decorations->second.binding,
+                .type    = descriptor_type(type_id, variable.storage_class),
+                .count   = count,
+            });
+        }
+
+        std::ranges::sort(bindings, [](const auto& lhs, const auto& rhs) {
+            return std::tie(lhs.set, lhs.binding) < std::tie(rhs.set, rhs.binding);
+        });
+
+        return bindings;
+    }
+
+    auto Module::type_size(const u32 type_id) const -> u32 {
+        const auto& type = types_.at(type_id);
+
+        switch (type.op) {
+        case OP_TYPE_BOOL:
+            return 4;
+        case OP_TYPE_INT:
+        case OP_TYPE_FLOAT:
+            return type.operands[0] / 8;
+        case OP_TYPE_VECTOR:
+            return type_size(type.operands[0]) * type.operands[1];
+        case OP_TYPE_MATRIX:
+            // only reached without a matrix stride, which means tightly packed columns
+            return type_size(type.operands[0]) * type.operands[1];
+        case OP_TYPE_ARRAY: {
+            const auto& decorations = decorations_.find(type_id);
+            const u32   stride      = (decorations != decorations_.end() && decorations->second.array_stride)
+                                          ? *decorations->second.array_stride
+                                          : type_size(type.operands[0]);
+            return stride * constant_value(type.operands[1]);
+        }
+        case OP_TYPE_STRUCT:
+            return struct_size(type_id);
+        default:
+            throw std::runtime_error("type has no size");
+        }
+    }
+
+    auto Module::struct_size(const u32 type_id) const -> u32 {
+        const auto& members    = types_.at(type_id).operands;
+        const auto  decorated  = member_decorations_.find(type_id);
+        u32         end_offset = 0;
+
+        for (u32 member = 0; member < members.size(); ++member) {
+            MemberDecorations decorations;
+            if (decorated != member_decorations_.end() && decorated->second.contains(member)) {
+                decorations = decorated->second.at(member);
+            }
+
+            const auto& member_type = types_.at(members[member]);
+
+            u32 size = 0;
+            if (member_type.op == OP_TYPE_MATRIX && decorations.matrix_stride) {
+                size = *decorations.matrix_stride * member_type.operands[1];
+            } else {
+                size = type_size(members[member]);
+            }
+
+            end_offset = std::max(end_offset, decorations.offset.value_or(end_offset) + size);
+        }
+
+        return end_offset;
+    }
+
+    auto Module::push_constant_range() const -> std::optional<std::pair<u32, u32>> {
+        for (const auto& variable : variables_) {
+            if (variable.storage_class != STORAGE_PUSH_CONSTANT) {
+                continue;
+            }
+
+            // the range starts at the first member, glsl allows offsetting a block into a range shared with other stages
+            const u32  block_type = pointee(variable.pointer_type);
+            const auto decorated  = member_decorations_.find(block_type);
+
+            u32 begin = 0;
+            if (decorated != member_decorations_.end()) {
+                begin = UINT32_MAX;
+                for (const auto& [member, decorations] : decorated->second) {
+                    begin = std::min(begin, decorations.offset.value_or(0));
+                }
+            }
+
+            const u32 end = struct_size(block_type);
+            return std::pair {begin, end - begin};
+        }
+
+        return std::nullopt;
+    }
+
+    auto Module::vertex_format(const u32 type_id) const -> std::optional<std::pair<std::string, u32>> {
+        const auto& type = types_.at(type_id);
+
+        u32 component_type  = type_id;
+        u32 component_count = 1;
+        if (type.op == OP_TYPE_VECTOR) {
+            component_type  = type.operands[0];
+            component_count = type.operands[1];
+        }
+
+        const auto& component = types_.at(component_type);
+        if ((component.op != OP_TYPE_FLOAT && component.op != OP_TYPE_INT) || component.operands[0] != 32) {
+            return std::nullopt;
+        }
+
+        const std::string suffix =
+            (component.op == OP_TYPE_FLOAT ? "Sfloat" : (component.operands[1] == 1 ? "Sint" : "Uint"));
+
+        std::string format = "eR32";
+        const char* channels[] = {"G32", "B32", "A32"};
+        for (u32 i = 1; i < component_count; ++i) {
+            format += channels[i - 1];
+        }
+
+        return std::pair {format + suffix, 4 * component_count};
+    }
+
+    auto Module::is_built_in(const u32 variable_id, const u32 type_id) const -> bool {
+        if (decorations_.contains(variable_id) && decorations_.at(variable_id).built_in) {
+            return true;
+        }
+
+        // gl_PerVertex style blocks mark their members instead
+        const auto decorated = member_decorations_.find(type_id);
+        return decorated != member_decorations_.end() &&
+               std::ranges::any_of(decorated->second, [](const auto& member) { return member.second.built_in; });
+    }
+
+    auto Module::vertex_inputs() const -> std::vector<VertexInput> {
+        std::vector<VertexInput> inputs;
+        if (stage_ != "eVertex") {
+            return inputs;
+        }
+
+        for (const auto& variable : variables_) {
+            const u32 type_id = pointee(variable.pointer_type);
+            if (variable.storage_class != STORAGE_INPUT || is_built_in(variable.id, type_id)) {
+                continue;
+            }
+
+            const auto decorations = decorations_.find(variable.id);
+            if (decorations == decorations_.end() || !decorations->second.location) {
+                throw std::runtime_error("vertex input without a location");
+            }
+
+            const auto name         = names_.find(variable.id);
+            const bool per_instance = name != names_.end() && name->second.starts_with(INSTANCE_INPUT_PREFIX);
+
+            // a matrix takes up one location per column, each of them a separate attribute
+            u32 column_type  = type_id;
+            u32 column_count = 1;
+            if (types_.at(type_id).op == OP_TYPE_MATRIX) {
+                column_type  = types_.at(type_id).operands[0];
+                column_count = types_.at(type_id).operands[1];
+            }
+
+            const auto format = vertex_format(column_type);
+            if (!format) {
+                throw std::runtime_error("vertex inputs have to be 32-bit scalars, vectors or matrices");
+            }
+
+            for (u32 column = 0; column < column_count; ++column) {
+                inputs.push_back({
+                    .location     = *decorations->second.location + column,
+                    .format       = format->first,
+                    .size         = format->second,
+                    .per_instance = per_instance,
+                });
+            }
+        }
+
+        std::ranges::sort(inputs, {}, &VertexInput::location);
+
+        return inputs;
+    }
+
+    auto Module::spec_constant_type(const u32 type_id) const -> std::string {
+        const auto& type = types_.at(type_id);
+
+        switch (type.op) {
+        case OP_TYPE_BOOL:
+            return "BOOL";
+        case OP_TYPE_INT:
+            return (type.operands[1] == 1 ? "INT" : "UINT");
+        case OP_TYPE_FLOAT:
+            return "FLOAT";
+        default:
+            throw std::runtime_error("specialization constant of unsupported type " + std::to_string(type.op));
+        }
+    }
+
+    auto Module::spec_constants() const -> std::vector<SpecConstant> {
+        std::vector<SpecConstant> constants;
+
+        for (const auto& [id, type] : spec_constant_types_) {
+            const auto decorations = decorations_.find(id);
+            if (decorations == decorations_.end() || !decorations->second.spec_id) {
+                continue;
+            }
+
+            constants.push_back({.id = *decorations->second.spec_id, .size = type_size(type), .type = spec_constant_type(type)});
+        }
+
+        std::ranges::sort(constants, {}, &SpecConstant::id);
+
+        return constants;
+    }
+
+    auto Module::local_size() const -> std::array<u32, 3> {
+        if (stage_ != "eCompute") {
+            return {0, 0, 0};
+        }
+
+        if (local_size_operands_.size() != 3) {
+            throw std::runtime_error("compute shader without a local size");
+        }
+
+        // a local size that is specialized at runtime can't be known here, the ids have to name plain constants
+        if (local_size_ids_) {
+            return {constant_value(local_size_operands_[0]),
+                    constant_value(local_size_operands_[1]),
+                    constant_value(local_size_operands_[2])};
+        }
+
+        return {local_size_operands_[0], local_size_operands_[1], local_size_operands_[2]};
+    }
+
+    auto read_words(const std::string& path) -> std::optional<std::vector<u32>> {
+        std::ifstream file(path, std::ios::ate | std::ios::binary);
+        if (!file.is_open()) {
+            return std::nullopt;
+        }
+
+        const auto byte_count = static_cast<u64>(file.tellg());
+        if (byte_count % sizeof(u32) != 0) {
+            return std::nullopt;
+        }
+
+        std::vector<u32> words(byte_count / sizeof(u32));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(words.data()), static_cast<std::streamsize>(byte_count));
+
+        return words;
+    }
+
+    auto generate(const Module& module, const std::string& identifier, const std::string& source_name) -> std::string {
+        const auto bindings       = module.bindings();
+        const auto push_constants = module.push_constant_range();
+        const auto vertex_inputs  = module.vertex_inputs();
+        const auto spec_constants = module.spec_constants();
+        const auto local_size     = module.local_size();
+        const auto stage          = "vk::ShaderStageFlagBits::" + module.stage();
+
+        std::string guard = "SYLK_SHADERS_" + identifier + "_REFLECTION_HPP";
+
+        std::ostringstream out;
+        out << "//\n// Generated from " << source_name << " by tools/reflect, do not edit.\n//\n\n";
+        out << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+        out << "#include <sylk/vulkan/shader/shader_reflection.hpp>\n\n#include <array>\n\n";
+        out << "namespace sylk {\n\n";
+
+        out << "    inline constexpr std::array<ReflectedBinding, " << bindings.size() << "> " << identifier << "_BINDINGS = {{\n";
+        for (const auto& binding : bindings) {
+            out << "        {.set = " << binding.set << ", .binding = " << binding.binding
+                << ", .type = vk::DescriptorType::" << binding.type << ", .count = " << binding.count << ", .stages = " << stage
+                << "},\n";
+        }
+        out << "    }};\n\n";
+
+        out << "    inline constexpr std::array<ReflectedPushConstants, " << (push_constants ? 1 : 0) << "> " << identifier
+            << "_PUSH_CONSTANTS = {{\n";
+        if (push_constants) {
+            out << "        {.offset = " << push_constants->first << ", .size = " << push_constants->second << ", .stages = " << stage
+                << "},\n";
+        }
+        out << "    }};\n\n";
+
+        // per vertex and per instance inputs are interleaved separately, each in location order
+        u32 vertex_stride   = 0;
+        u32 instance_stride = 0;
+        out << "    inline constexpr std::array<ReflectedVertexInput, " << vertex_inputs.size() << "> " << identifier
+            << "_VERTEX_INPUTS = {{\n";
+        for (const auto& input : vertex_inputs) {
+            auto& stride = (input.per_instance ? instance_stride : vertex_stride);
+            out << "        {.location = " << input.location << ", .format = vk::Format::" << input.format << ", .offset = " << stride
+                << ", .rate = vk::VertexInputRate::" << (input.per_instance ? "eInstance" : "eVertex") << "},\n";
+            stride += input.size;
+        }
+        out << "    }};\n\n";
+
+        out << "    inline constexpr std::array<ReflectedSpecConstant, " << spec_constants.size() << "> " << identifier
+            << "_SPEC_CONSTANTS = {{\n";
+        for (const auto& constant : spec_constants) {
+            out << "        {.id = " << constant.id << ", .size = " << constant.size << ", .type = ESpecConstantType::" << constant.type
+                << "},\n";
+        }
+        out << "    }};\n\n";
+
+        out << "    inline constexpr ShaderReflection " << identifier << "_REFLECTION = {\n";
+        out << "        .stage           = " << stage << ",\n";
+        out << "        .bindings        = " << identifier << "_BINDINGS,\n";
+        out << "        .push_constants  = " << identifier << "_PUSH_CONSTANTS,\n";
+        out << "        .vertex_inputs   = " << identifier << "_VERTEX_INPUTS,\n";
+        out << "        .spec_constants  = " << identifier << "_SPEC_CONSTANTS,\n";
+        out << "        .vertex_stride   = " << vertex_stride << ",\n";
+        out << "        .instance_stride = " << instance_stride << ",\n";
+        out << "        .local_size      = {" << local_size[0] << ", " << local_size[1] << ", " << local_size[2] << "},\n";
+        out << "    };\n\n";
+
+        out << "}  // namespace sylk\n\n#endif  // " << guard << "\n";
+
+        return out.str();
+    }
+}  // namespace
+
+auto main(const int argc, const char** argv) -> int {
+    if (argc != 5) {
+        std::cerr << "usage: sylk_reflect <input.spv> <output.hpp> <IDENTIFIER> <source name>\n";
+        return 1;
+    }
+
+    const std::string input_path  = argv[1];
+    const std::string output_path = argv[2];
+
+    auto words = read_words(input_path);
+    if (!words) {
+        std::cerr << "sylk_reflect: could not read " << input_path << "\n";
+        return 1;
+    }
+
+    Module module(std::move(*words));
+    if (!module.parse()) {
+        return 1;
+    }
+
+    std::string header;
+    try {
+        header = generate(module, argv[3], argv[4]);
+    } catch (const std::exception& e) {
+        std::cerr << "sylk_reflect: " << input_path << ": " << e.what() << "\n";
+        return 1;
+    }
+
+    std::ofstream output(output_path, std::ios::trunc);
+    output << header;
+
+    return (output.good() ? 0 : 1);
+}